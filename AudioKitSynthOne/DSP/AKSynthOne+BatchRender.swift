@@ -0,0 +1,58 @@
+//
+//  AKSynthOne+BatchRender.swift
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Preset previews rendered faster than real time by S1BatchRenderer, off the audio engine.
+
+import AudioKit
+import Foundation
+
+extension AKSynthOne {
+
+    /// Batch renderer reading the bundled wavetables; nil if they failed to load
+    static func makeBatchRenderer(sampleRate: Double = AKSettings.sampleRate) -> S1BatchRenderer? {
+        let wavetables = bundledWavetables()
+        let samples = wavetables.waveforms.flatMap { $0 }
+        let frequencies = wavetables.bandlimitFrequencies
+        return S1BatchRenderer(wavetables: samples,
+                               sampleCount: samples.count,
+                               bandlimitFrequencies: frequencies,
+                               frequencyCount: frequencies.count,
+                               sampleRate: sampleRate)
+    }
+
+    /// Two bars of a chord under a short melody at 120 bpm, then two seconds of release
+    static func previewPhrase() -> S1BatchRenderPhrase {
+        var events: [S1BatchRenderEvent] = []
+        func note(_ noteNumber: UInt8, _ velocity: UInt8, from start: Double, to end: Double) {
+            events.append(S1BatchRenderEvent(time: start, noteNumber: noteNumber, velocity: velocity))
+            events.append(S1BatchRenderEvent(time: end, noteNumber: noteNumber, velocity: 0))
+        }
+        [48, 55, 60, 64].forEach { note($0, 90, from: 0, to: 4) }
+        for (i, noteNumber) in [72, 74, 76, 79, 76, 74, 72, 67].enumerated() {
+            note(UInt8(noteNumber), 100, from: Double(i) * 0.5, to: Double(i) * 0.5 + 0.45)
+        }
+        return S1BatchRenderPhrase(events: events, count: events.count, duration: 6)
+    }
+
+    /// Render each preset playing phrase into directory, one file per preset named by its uid.
+    /// completion runs on the main queue with the presets whose file could not be written
+    static func renderPreviews(of presets: [Preset],
+                               phrase: S1BatchRenderPhrase = previewPhrase(),
+                               to directory: URL,
+                               format: S1BatchRenderFileFormat = .AAC,
+                               renderer: S1BatchRenderer,
+                               completion: @escaping ([Preset]) -> Void) {
+        let pathExtension = format == .AAC ? "m4a" : "caf"
+        let jobs = presets.map { preset -> S1BatchRenderJob in
+            let url = directory.appendingPathComponent(preset.uid).appendingPathExtension(pathExtension)
+            return S1BatchRenderJob(parameters: preset.dspParameters(), phrase: phrase, outputURL: url, seed: 0)
+        }
+        renderer.renderJobs(jobs, format: format) { failedJobs in
+            completion(failedJobs.map { presets[$0] })
+        }
+    }
+}
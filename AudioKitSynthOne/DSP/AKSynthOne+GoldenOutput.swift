@@ -0,0 +1,290 @@
+//
+//  AKSynthOne+GoldenOutput.swift
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  DEBUG builds: renders every factory preset offline with a fixed seed and MIDI phrase, and compares the output
+//  with a stored reference: an exact hash, else band spectrum and envelope within a tolerance in dB.
+//  GoldenOutputTests runs the check against AudioKitSynthOneTests/goldenOutput.json; the launch arguments run it
+//  from the app and record a new reference.
+
+#if DEBUG
+
+import Accelerate
+import AudioKit
+import Foundation
+
+extension AKSynthOne {
+
+    /// Launch arguments, read through the argument domain of UserDefaults:
+    /// -S1GoldenOutput check|record, and -S1GoldenOutputTolerance dB (default 0.5)
+    static let goldenOutputModeKey = "S1GoldenOutput"
+    static let goldenOutputToleranceKey = "S1GoldenOutputTolerance"
+    static let goldenOutputDefaultTolerance: Float = 0.5
+
+    /// Fingerprint of one rendered preset
+    struct GoldenOutput: Codable {
+        var hash: String            // FNV-1a of the output quantized to 16 bits
+        var bands: [Float]          // dB of the average power spectrum in log-spaced bands, 20 Hz...20 kHz
+        var envelope: [Float]       // RMS dB of equal segments of the render
+
+        // largest difference in dB of bands and envelope
+        func distance(to other: GoldenOutput) -> Float {
+            guard bands.count == other.bands.count, envelope.count == other.envelope.count else { return .infinity }
+            return zip(bands + envelope, other.bands + other.envelope).map { abs($0 - $1) }.max() ?? 0
+        }
+    }
+
+    struct GoldenOutputReference: Codable {
+        var version = 1
+        var sampleRate: Double
+        var seed: UInt32
+        var presets: [String: GoldenOutput]
+    }
+
+    // MARK: - Phrase
+
+    private static let goldenSeed: UInt32 = 0x5EED_0001
+    private static let goldenFramesPerRender: AVAudioFrameCount = 512
+
+    // note on/off at render indexes of goldenFramesPerRender frames, about 4.7 seconds at 44.1 kHz
+    private static let goldenPhrase: [(render: Int, note: UInt8, velocity: UInt8)] = [
+        // chord
+        (0, 48, 100), (0, 60, 90), (0, 64, 80), (0, 67, 70),
+        (86, 48, 0), (86, 60, 0), (86, 64, 0), (86, 67, 0),
+        // overlapping melody
+        (100, 72, 110), (120, 74, 90), (121, 72, 0), (140, 76, 70), (141, 74, 0),
+        (160, 79, 127), (161, 76, 0), (200, 79, 0),
+        // low held note, then the release tail
+        (220, 36, 100), (300, 36, 0)
+    ]
+    private static let goldenRenderCount = 400
+
+    // MARK: - Check
+
+    /// Main thread.  Renders every preset of the factory banks on a background queue; in record mode writes the
+    /// reference to documents/goldenOutput.json, otherwise compares with the reference at referenceURL, by default
+    /// goldenOutput.json of the app bundle, or of documents.  completion receives a report, and whether the presets
+    /// matched a non-empty reference or the reference was written, on the main thread
+    static func runGoldenOutputCheck(record: Bool, tolerance: Float, referenceURL: URL? = nil,
+                                     completion: @escaping (String, Bool) -> Void) {
+        let synth = AKSynthOne()
+        guard let au = synth.internalAU else {
+            completion("golden output: no audio unit", false)
+            return
+        }
+        let documents = FileManager.default.urls(for: .documentDirectory, in: .userDomainMask)[0]
+        let documentsURL = documents.appendingPathComponent("goldenOutput.json")
+        let referenceURL = referenceURL ??
+            Bundle.main.url(forResource: "goldenOutput", withExtension: "json") ?? documentsURL
+
+        DispatchQueue.global(qos: .userInitiated).async {
+            var outputs: [String: GoldenOutput] = [:]
+            for bank in initBanks {
+                guard let path = Bundle.main.path(forResource: bank, ofType: "json"),
+                    let data = FileManager.default.contents(atPath: path),
+                    let jsonArray = (try? JSONSerialization.jsonObject(with: data, options: [])) as? [Any] else { continue }
+                for preset in Preset.parseDataToPresets(jsonArray: jsonArray) {
+                    if let output = renderGoldenOutput(au, parameters: preset.dspParameters()) {
+                        outputs["\(bank)/\(preset.position) \(preset.name)"] = output
+                    }
+                }
+            }
+            let sampleRate = au.outputBusses[0].format.sampleRate
+            let report: (String, Bool)
+            if record {
+                report = writeGoldenOutput(GoldenOutputReference(sampleRate: sampleRate, seed: goldenSeed, presets: outputs),
+                                           to: documentsURL)
+            } else {
+                report = compareGoldenOutput(outputs, sampleRate: sampleRate, referenceURL: referenceURL, tolerance: tolerance)
+            }
+            DispatchQueue.main.async {
+                withExtendedLifetime(synth) { completion(report.0, report.1) }
+            }
+        }
+    }
+
+    private static func writeGoldenOutput(_ reference: GoldenOutputReference, to url: URL) -> (String, Bool) {
+        do {
+            let encoder = JSONEncoder()
+            encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+            try encoder.encode(reference).write(to: url, options: .atomic)
+            return ("golden output: recorded \(reference.presets.count) presets to \(url.path)", true)
+        } catch {
+            return ("golden output: error writing \(url.path): \(error)", false)
+        }
+    }
+
+    private static func compareGoldenOutput(_ outputs: [String: GoldenOutput], sampleRate: Double,
+                                            referenceURL: URL, tolerance: Float) -> (String, Bool) {
+        guard let data = try? Data(contentsOf: referenceURL),
+            let reference = try? JSONDecoder().decode(GoldenOutputReference.self, from: data) else {
+            return ("golden output: no reference at \(referenceURL.path); run with -\(goldenOutputModeKey) record", false)
+        }
+        guard !reference.presets.isEmpty else {
+            return ("golden output: the reference at \(referenceURL.path) has no presets; record one on a device with " +
+                "-\(goldenOutputModeKey) record and replace AudioKitSynthOneTests/goldenOutput.json with it", false)
+        }
+        guard reference.sampleRate == sampleRate, reference.seed == goldenSeed else {
+            return ("golden output: reference rendered at \(reference.sampleRate) Hz with seed \(reference.seed), " +
+                "not \(sampleRate) Hz with seed \(goldenSeed)", false)
+        }
+        var exact = 0
+        var withinTolerance = 0
+        var failures: [String] = []
+        for (key, output) in outputs.sorted(by: { $0.key < $1.key }) {
+            guard let expected = reference.presets[key] else {
+                failures.append("\(key): not in reference")
+                continue
+            }
+            if output.hash == expected.hash {
+                exact += 1
+            } else {
+                let distance = output.distance(to: expected)
+                if distance <= tolerance {
+                    withinTolerance += 1
+                } else {
+                    failures.append("\(key): differs by \(distance) dB")
+                }
+            }
+        }
+        for key in reference.presets.keys where outputs[key] == nil {
+            failures.append("\(key): not rendered")
+        }
+        let report = "golden output: \(exact) exact, \(withinTolerance) within \(tolerance) dB, \(failures.count) failed" +
+            failures.map { "\n    " + $0 }.joined()
+        return (report, failures.isEmpty)
+    }
+
+    // MARK: - Render
+
+    // Render the phrase from freshly allocated render resources, so no state carries over from the previous preset
+    private static func renderGoldenOutput(_ au: AKAudioUnitType, parameters: [Float]) -> GoldenOutput? {
+        if au.renderResourcesAllocated {
+            au.deallocateRenderResources()
+        }
+        au.setRandomSeed(goldenSeed)
+        guard (try? au.allocateRenderResources()) != nil else { return nil }
+        defer { au.deallocateRenderResources() }
+
+        // presets store a subset of the parameters; the rest keep the defaults of a new synth
+        var preset = (0..<Int(S1Parameter.S1ParameterCount.rawValue)).map { au.getDefault(S1Parameter(rawValue: Int32($0))!) }
+        for (i, value) in parameters.enumerated() where !value.isNaN {
+            preset[i] = value
+        }
+        au.loadPreset(preset, count: Int32(preset.count))
+
+        let format = au.outputBusses[0].format
+        guard let buffer = AVAudioPCMBuffer(pcmFormat: format, frameCapacity: goldenFramesPerRender),
+            let channels = buffer.floatChannelData else { return nil }
+        let channelCount = Int(format.channelCount)
+        let frameCount = Int(goldenFramesPerRender)
+        let renderBlock = au.renderBlock
+        var mono = [Float](repeating: 0, count: goldenRenderCount * frameCount)
+        var hash: UInt64 = 0xcbf29ce484222325
+        var timestamp = AudioTimeStamp()
+        timestamp.mFlags = .sampleTimeValid
+
+        var event = 0
+        for render in 0..<goldenRenderCount {
+            while event < goldenPhrase.count, goldenPhrase[event].render == render {
+                let (_, note, velocity) = goldenPhrase[event]
+                if velocity > 0 {
+                    au.startNote(note, velocity: velocity)
+                } else {
+                    au.stopNote(note)
+                }
+                event += 1
+            }
+            buffer.frameLength = goldenFramesPerRender
+            var flags = AudioUnitRenderActionFlags()
+            guard renderBlock(&flags, &timestamp, goldenFramesPerRender, 0, buffer.mutableAudioBufferList, nil) == noErr else {
+                return nil
+            }
+            timestamp.mSampleTime += Double(frameCount)
+            for frame in 0..<frameCount {
+                var sum: Float = 0
+                for channel in 0..<channelCount {
+                    let sample = channels[channel][frame]
+                    sum += sample
+                    let quantized = UInt16(bitPattern: Int16(max(-1, min(1, sample)) * 32_767))
+                    hash = (hash ^ UInt64(quantized)) &* 0x100000001b3
+                }
+                mono[render * frameCount + frame] = sum / Float(channelCount)
+            }
+        }
+        return GoldenOutput(hash: String(hash, radix: 16),
+                            bands: spectrumBands(mono, sampleRate: format.sampleRate),
+                            envelope: envelope(mono))
+    }
+
+    private static func decibels(_ power: Float) -> Float {
+        return 10 * log10(max(power, 1e-12))
+    }
+
+    // average power spectrum of Hann windowed 4096 frame blocks, summed into 24 bands from 20 Hz to 20 kHz
+    private static func spectrumBands(_ samples: [Float], sampleRate: Double) -> [Float] {
+        let log2n = vDSP_Length(12)
+        let n = 1 << 12
+        guard let setup = vDSP_create_fftsetup(log2n, FFTRadix(kFFTRadix2)) else { return [] }
+        defer { vDSP_destroy_fftsetup(setup) }
+
+        var window = [Float](repeating: 0, count: n)
+        vDSP_hann_window(&window, vDSP_Length(n), Int32(vDSP_HANN_NORM))
+        var windowed = [Float](repeating: 0, count: n)
+        var real = [Float](repeating: 0, count: n / 2)
+        var imaginary = [Float](repeating: 0, count: n / 2)
+        var power = [Float](repeating: 0, count: n / 2)
+        var blockPower = [Float](repeating: 0, count: n / 2)
+        var blockCount = 0
+        var start = 0
+        while start + n <= samples.count {
+            samples.withUnsafeBufferPointer { block in
+                vDSP_vmul(block.baseAddress! + start, 1, window, 1, &windowed, 1, vDSP_Length(n))
+            }
+            real.withUnsafeMutableBufferPointer { realPointer in
+                imaginary.withUnsafeMutableBufferPointer { imaginaryPointer in
+                    var split = DSPSplitComplex(realp: realPointer.baseAddress!, imagp: imaginaryPointer.baseAddress!)
+                    windowed.withUnsafeBytes { bytes in
+                        let complex = bytes.bindMemory(to: DSPComplex.self)
+                        vDSP_ctoz(complex.baseAddress!, 2, &split, 1, vDSP_Length(n / 2))
+                    }
+                    vDSP_fft_zrip(setup, &split, 1, log2n, FFTDirection(FFT_FORWARD))
+                    vDSP_zvmags(&split, 1, &blockPower, 1, vDSP_Length(n / 2))
+                }
+            }
+            vDSP_vadd(power, 1, blockPower, 1, &power, 1, vDSP_Length(n / 2))
+            blockCount += 1
+            start += n
+        }
+        guard blockCount > 0 else { return [] }
+
+        let bandCount = 24
+        let binHz = sampleRate / Double(n)
+        return (0..<bandCount).map { band in
+            let low = 20 * pow(1_000, Double(band) / Double(bandCount))
+            let high = 20 * pow(1_000, Double(band + 1) / Double(bandCount))
+            let firstBin = max(1, Int(low / binHz))
+            let lastBin = min(n / 2 - 1, max(firstBin, Int(high / binHz)))
+            let bandPower = power[firstBin...lastBin].reduce(0, +)
+            return decibels(bandPower / Float(blockCount))
+        }
+    }
+
+    // RMS of 32 equal segments
+    private static func envelope(_ samples: [Float]) -> [Float] {
+        let segmentCount = 32
+        let segmentLength = samples.count / segmentCount
+        return (0..<segmentCount).map { segment in
+            var meanSquare: Float = 0
+            samples.withUnsafeBufferPointer { block in
+                vDSP_measqv(block.baseAddress! + segment * segmentLength, 1, &meanSquare, vDSP_Length(segmentLength))
+            }
+            return decibels(meanSquare)
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,91 @@
+//
+//  AKSynthOne+RealtimeSafety.swift
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  DEBUG builds: plays the synth through the paths that have allocated or locked on the render thread before
+//  (arpeggiator and sequencer, mono/poly switching, preset loads) and reports what the realtime watchdog caught.
+
+#if DEBUG
+
+import Foundation
+import AudioKit
+
+extension AKSynthOne {
+
+    /// Launch argument that runs runRealtimeSafetyCheck once AudioKit has started
+    static let realtimeSafetyCheckArgument = "-S1RealtimeSafetyCheck"
+
+    /// Main thread.  Takes a few seconds; completion receives the report of every violation, empty if none
+    open func runRealtimeSafetyCheck(completion: @escaping (String) -> Void) {
+        let chord: [MIDINoteNumber] = [48, 55, 60, 64, 67, 71]
+        let savedParameters = getSynthParameters()
+        var presetParameters = savedParameters
+        let firstViolation = S1RealtimeWatchdogViolationCount()
+
+        let steps: [() -> Void] = [
+            // poly voices
+            { chord.forEach { self.play(noteNumber: $0, velocity: 100) } },
+            { chord.forEach { self.stop(noteNumber: $0) } },
+
+            // mono/poly switching with held notes
+            {
+                self.setSynthParameter(.isMono, 1)
+                chord.forEach { self.play(noteNumber: $0, velocity: 100) }
+            },
+            { self.setSynthParameter(.isMono, 0) },
+            { self.setSynthParameter(.isMono, 1) },
+            {
+                chord.forEach { self.stop(noteNumber: $0) }
+                self.setSynthParameter(.isMono, 0)
+            },
+
+            // arpeggiator, then sequencer, with held notes
+            {
+                self.setSynthParameter(.arpRate, 200)
+                self.setSynthParameter(.arpIsSequencer, 0)
+                self.setSynthParameter(.arpIsOn, 1)
+                chord.prefix(3).forEach { self.play(noteNumber: $0, velocity: 100) }
+            },
+            { self.setSynthParameter(.arpIsSequencer, 1) },
+            { chord.suffix(3).forEach { self.play(noteNumber: $0, velocity: 100) } },
+            {
+                chord.forEach { self.stop(noteNumber: $0) }
+                self.setSynthParameter(.arpIsOn, 0)
+            },
+
+            // preset loads while notes play: mono/poly, arp and filter changes all in one buffer
+            { chord.forEach { self.play(noteNumber: $0, velocity: 100) } },
+            {
+                presetParameters[Int(S1Parameter.isMono.rawValue)] = 1
+                presetParameters[Int(S1Parameter.arpIsOn.rawValue)] = 1
+                self.loadPreset(presetParameters)
+            },
+            {
+                presetParameters[Int(S1Parameter.isMono.rawValue)] = 0
+                presetParameters[Int(S1Parameter.arpIsOn.rawValue)] = 0
+                presetParameters[Int(S1Parameter.cutoff.rawValue)] = 400
+                self.loadPreset(presetParameters)
+            },
+            {
+                self.loadPreset(savedParameters)
+                chord.forEach { self.stop(noteNumber: $0) }
+            },
+            { self.stopAllNotes() }
+        ]
+
+        func run(_ step: Int) {
+            guard step < steps.count else {
+                completion(S1RealtimeWatchdogReport(firstViolation, nil))
+                return
+            }
+            steps[step]()
+            DispatchQueue.main.asyncAfter(deadline: .now() + 0.25) { run(step + 1) }
+        }
+        run(0)
+    }
+}
+
+#endif
@@ -50,6 +50,47 @@ import AudioKit
         return Double(internalAU?.getSynthParameter(parameter) ?? 0)
     }
 
+    /// Current value of every parameter, indexed by S1Parameter rawValue
+    open func getSynthParameters() -> [Float] {
+        let parameterCount = Int(S1Parameter.S1ParameterCount.rawValue)
+        return (0..<parameterCount).map { index in
+            guard let parameter = S1Parameter(rawValue: Int32(index)) else { return 0 }
+            return internalAU?.getSynthParameter(parameter) ?? 0
+        }
+    }
+
+    /// Replace every parameter at once; the DSP applies them together at the start of the next buffer
+    open func loadPreset(_ parameters: [Float]) {
+        internalAU?.loadPreset(parameters, count: Int32(parameters.count))
+    }
+
+    /// Sequencer pattern of up to 128 steps; the DSP switches to it at the start of the next buffer.
+    /// It plays until clearSequencerPattern, whatever the sequencer parameters and presets
+    open func setSequencerPattern(_ steps: [S1SequencerStep]) {
+        internalAU?.setSequencerPattern(steps, count: Int32(steps.count))
+    }
+
+    /// Return to the pattern of the sequencer parameters
+    open func clearSequencerPattern() {
+        internalAU?.clearSequencerPattern()
+    }
+
+    /// Time the DSP took for the latest render cycle, against its budget of frameCount / sampleRate, with peaks,
+    /// averages and over-budget counts since rendering started or resetDSPLoad().  Main thread
+    open var dspLoad: S1DSPLoad {
+        return internalAU?.dspLoad ?? S1DSPLoad()
+    }
+
+    open func resetDSPLoad() {
+        internalAU?.resetDSPLoad()
+    }
+
+    /// Seed of the noise oscillators and sequencer step probability.  Set while not rendering; output repeats
+    /// exactly from the next allocateRenderResources
+    open func setRandomSeed(_ seed: UInt32) {
+        internalAU?.setRandomSeed(seed)
+    }
+
     open func getDependentParameter(_ parameter: S1Parameter) -> Double {
         return Double(internalAU?.getDependentParameter(parameter) ?? 0)
     }
@@ -166,6 +207,19 @@ import AudioKit
 
     /// Initialize the synth with defaults
     public convenience override init() {
+        let wavetables = AKSynthOne.bundledWavetables()
+        self.init(waveformArray: wavetables.waveforms, bandlimitArray: wavetables.bandlimitFrequencies)
+    }
+
+    /// The band-limited waveforms of the app bundle in table index order, and the frequency of each band.
+    /// Read from the bundle once per process
+    static func bundledWavetables() -> (waveforms: [AKTable], bandlimitFrequencies: [Float]) {
+        return loadedBundledWavetables
+    }
+
+    private static let loadedBundledWavetables = loadBundledWavetables()
+
+    private static func loadBundledWavetables() -> (waveforms: [AKTable], bandlimitFrequencies: [Float]) {
 
         /// read list of bandlimited waveform filenames stored as an array of Strings
         var finalFileNames = [String]()
@@ -231,7 +285,7 @@ import AudioKit
             AKLog("Can't locate bandlimited waveform frequencies in the bundle")
         }
 
-        self.init(waveformArray: finalArray, bandlimitArray: finalFrequencies)
+        return (finalArray, finalFrequencies)
     }
 
     /// Initialize this synth
@@ -249,16 +303,14 @@ import AudioKit
             self?.avAudioNode = avAudioUnit
             self?.midiInstrument = avAudioUnit as? AVAudioUnitMIDIInstrument
             self?.internalAU = avAudioUnit.auAudioUnit as? AKAudioUnitType
-            for i in 0..<AKSynthOne.SNUMBANDLIMITEDFTABLES {
-                self?.internalAU?.setBandlimitFrequency(UInt32(i), withFrequency: bandlimitArray[i])
-                for j in 0..<AKSynthOne.SNUMWAVEFORMS {
-                    let tableIndex = i * AKSynthOne.SNUMWAVEFORMS + j
-                    self?.internalAU?.setupWaveform(UInt32(tableIndex), size: Int32(AKSynthOne.SFTABLESIZE))
-                    let waveform: AKTable = waveformArray[tableIndex]
-                    for (k, sample) in waveform.enumerated() {
-                        self?.internalAU?.setWaveform(UInt32(tableIndex), withValue: sample, at: UInt32(k))
-                    }
-                }
+            // one copy of the tables for every synth in the process
+            let samples = waveformArray.flatMap { $0 }
+            if self?.internalAU?.setWavetables(samples,
+                                               sampleCount: Int32(samples.count),
+                                               bandlimitFrequencies: bandlimitArray,
+                                               frequencyCount: Int32(bandlimitArray.count)) == false {
+                AKLog("ERROR: expected \(AKSynthOne.SNUMWAVEFORMS * AKSynthOne.SNUMBANDLIMITEDFTABLES) waveforms " +
+                      "of \(AKSynthOne.SFTABLESIZE) samples and \(AKSynthOne.SNUMBANDLIMITEDFTABLES) band frequencies")
             }
             self?.internalAU?.parameters = self?.parameters
             self?.internalAU?.s1Delegate = self
@@ -348,4 +400,23 @@ extension AKSynthOne: S1TuningTable {
         return Double(internalAU?.getTuningTableFrequency(Int32(index)) ?? 440)
     }
 
+    public func setTuningTable(_ frequencies: [Double], firstNote: Int, retune: Bool) {
+
+        let f = frequencies.map { Float($0) }
+        internalAU?.setTuningTable(f, count: Int32(f.count), firstNote: Int32(firstNote), retune: retune)
+    }
+
+    /// Tuning of a Scala scale (.scl) and optional keyboard mapping (.kbm), parsed by the DSP.
+    /// Returns false if either is malformed
+    public func setScalaTuning(_ scl: String, keyboardMapping kbm: String?, retune: Bool) -> Bool {
+
+        return internalAU?.setScalaTuning(scl, keyboardMapping: kbm, retune: retune) ?? false
+    }
+
+    /// Ratios of one period of a Scala scale, starting with 1/1; nil if the scale is malformed
+    public static func scalaMasterSet(_ scl: String) -> [Double]? {
+
+        return S1AudioUnit.scalaMasterSet(scl)?.map { $0.doubleValue }
+    }
+
 }
@@ -13,8 +13,9 @@
 
 #define S1_MAX_POLYPHONY (6)
 #define S1_NUM_MIDI_NOTES (128)
-
-@class AEMessageQueue;
+#define S1_MAX_SEQUENCER_STEPS (128)
+#define S1_MAX_TUNING_TABLE_NOTES (1024)
+#define S1_NUM_BANDLIMITED_FTABLES (13)
 
 // helper for midi/render thread communication: held+playing notes
 typedef struct NoteNumber {
@@ -46,12 +47,43 @@ typedef struct HeldNotes {
     bool heldNotes[S1_NUM_MIDI_NOTES];
 } HeldNotes;
 
+// helper for main/render thread communication: one step of a sequencer pattern
+typedef struct S1SequencerStep {
+    int note;           // semitones (12ET) from the held key
+    int octave;         // octave boost, away from the held key
+    int velocity;       // [1, 127], or 0 for the velocity of the held key
+    float gate;         // fraction of the step the notes are held, (0, 1]; a step of gate 0 is a rest
+    float probability;  // [0, 1]
+    bool isOn;
+} S1SequencerStep;
+
 // helper for main+render thread communcation: arp beat counter, and number of held notes
 typedef struct S1ArpBeatCounter {
     int beatCounter;
     int heldNotesCount;
 } S1ArpBeatCounter;
 
+// helper for render/main thread communication: DSP load of the latest render cycle, and totals since rendering started
+// or the peaks were reset.  The budget of a cycle is frameCount / sampleRate.  The seconds of each stage are those of
+// the latest cycle whose stages were timed, one cycle in S1DSPLoadMonitor::kStageTimingInterval
+typedef struct S1DSPLoad {
+    uint64_t cycleCount;
+    uint64_t overBudgetCount;   // cycles that took longer than their budget
+    double budgetSeconds;
+    double cycleSeconds;
+    double peakCycleSeconds;
+    double load;                // cycleSeconds / budgetSeconds
+    double peakLoad;
+    double averageLoad;         // exponential average over about one second
+    double setupSeconds;        // per-buffer updates, parameter events and the UI state snapshot
+    double modulationSeconds;   // portamento and LFOs
+    double sequencerSeconds;
+    double voicesSeconds;
+    double effectsSeconds;
+    int activeVoices;
+    int peakActiveVoices;
+} S1DSPLoad;
+
 
 @protocol S1Protocol
 
@@ -66,10 +98,6 @@ typedef struct S1ArpBeatCounter {
 @end
 
 @interface S1AudioUnit : AKAudioUnit
-{
-    @public
-    AEMessageQueue  *_messageQueue;
-}
 
 @property (nonatomic) NSArray *parameters;
 @property (nonatomic, weak) id<S1Protocol> s1Delegate;
@@ -80,6 +108,16 @@ typedef struct S1ArpBeatCounter {
 - (float)getDependentParameter:(S1Parameter)param;
 - (void)setDependentParameter:(S1Parameter)param value:(float)value payload:(int)payload;
 
+// all parameters at once, indexed by S1Parameter; applied by the render thread at the next buffer
+- (void)loadPreset:(const float *)parameters count:(int)count;
+
+// sequencer pattern of up to S1_MAX_SEQUENCER_STEPS steps; applied by the render thread at the next buffer.
+// Plays until clearSequencerPattern; sequencer parameters and presets do not replace it
+- (void)setSequencerPattern:(const S1SequencerStep *)steps count:(int)count;
+
+// return to the pattern of the sequencer parameters
+- (void)clearSequencerPattern;
+
 - (float)getMinimum:(S1Parameter)param;
 - (float)getMaximum:(S1Parameter)param;
 - (float)getDefault:(S1Parameter)param;
@@ -88,6 +126,14 @@ typedef struct S1ArpBeatCounter {
 - (void)setWaveform:(UInt32)tableIndex withValue:(float)value atIndex:(UInt32)sampleIndex;
 - (void)setBandlimitFrequency:(UInt32)blIndex withFrequency:(float)frequency;
 
+// All waveforms and band frequencies at once, as tables shared with every other S1AudioUnit loading the same ones.
+// samples: S1_NUM_WAVEFORMS * S1_NUM_BANDLIMITED_FTABLES tables of 4096 samples in table index order.
+// NO if a count differs.  Before the first note
+- (BOOL)setWavetables:(const float *)samples
+          sampleCount:(int)sampleCount
+ bandlimitFrequencies:(const float *)frequencies
+       frequencyCount:(int)frequencyCount;
+
 - (void)stopNote:(uint8_t)note;
 - (void)startNote:(uint8_t)note velocity:(uint8_t)velocity;
 - (void)startNote:(uint8_t)note velocity:(uint8_t)velocity frequency:(float)frequency;
@@ -102,12 +148,33 @@ typedef struct S1ArpBeatCounter {
 - (float)getTuningTableFrequency:(int)index;
 - (void)setTuningTableNPO:(int)npo;
 
+// frequencies of note numbers firstNote...firstNote + count - 1, count <= S1_MAX_TUNING_TABLE_NOTES; applied by the
+// render thread at the next buffer.  retune: sounding notes move to the new tuning, otherwise only new notes use it
+- (void)setTuningTable:(const float *)frequencies count:(int)count firstNote:(int)firstNote retune:(BOOL)retune;
+
+// Scala scale and keyboard mapping file contents; a nil mapping maps the scale linearly with degree 0 at middle C.
+// Returns NO and keeps the current tuning if either is malformed
+- (BOOL)setScalaTuning:(NSString *)scl keyboardMapping:(NSString *)kbm retune:(BOOL)retune;
+
+// ratios of one period of a Scala scale, starting with 1/1; nil if the scale is malformed
++ (NSArray<NSNumber *> *)scalaMasterSet:(NSString *)scl;
+
+// latest DSP load published by the render thread.  MAIN THREAD
+@property (nonatomic, readonly) S1DSPLoad dspLoad;
+
+// restart the peaks, averages and counts of dspLoad at the next render cycle
+- (void)resetDSPLoad;
+
+// seed of the noise oscillators and sequencer step probability; renders repeat exactly from allocateRenderResources.
+// MAIN THREAD, while not rendering
+- (void)setRandomSeed:(UInt32)seed;
+
 ///auv3, not yet used
 - (void)setParameter:(AUParameterAddress)address value:(AUValue)value;
 - (AUValue)getParameter:(AUParameterAddress)address;
 - (void)createParameters;
 
-// protected passthroughs for S1Protocol called by DSP on main thread
+// protected passthroughs for S1Protocol called on main thread when the DSP state changes
 - (void)dependentParameterDidChange:(DependentParameter)param;
 - (void)arpBeatCounterDidChange:(S1ArpBeatCounter)arpBeatcounter;
 - (void)heldNotesDidChange:(HeldNotes)heldNotes;
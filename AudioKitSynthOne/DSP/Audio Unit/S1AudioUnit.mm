@@ -7,8 +7,11 @@
 //
 
 #import "S1AudioUnit.h"
+#import <QuartzCore/QuartzCore.h>
 #import "S1DSPKernel.hpp"
-#import "AEMessageQueue.h"
+#import "S1Scala.hpp"
+#import "S1RealtimeWatchdog.h"
+#import "AEWeakRetainingProxy.h"
 #import "AudioKit/BufferedAudioBus.hpp"
 #import <AudioKit/AudioKit-swift.h>
 
@@ -17,6 +20,15 @@
     std::unique_ptr<S1DSPKernel> _kernel;
     BufferedOutputBus _outputBusBuffer;
     AUHostMusicalContextBlock _musicalContext;
+    AUHostTransportStateBlock _transportState;
+
+    // main thread poll of the state published by the render thread
+    CADisplayLink *_statePollLink;
+    S1StateSnapshot _stateSnapshot;
+    S1DSPLoad _dspLoad;
+
+    // real-time violations already logged
+    NSInteger _loggedViolations;
 }
 
 @synthesize parameterTree = _parameterTree;
@@ -27,7 +39,7 @@
 }
 
 - (void)setSynthParameter:(S1Parameter)param value:(float)value {
-    _kernel->setSynthParameter(param, value);
+    _kernel->postSynthParameter(param, value);
 }
 
 - (float)getDependentParameter:(S1Parameter)param {
@@ -38,9 +50,25 @@
     _kernel->setDependentParameter(param, value, payload);
 }
 
+- (void)loadPreset:(const float *)parameters count:(int)count {
+    DSPParameters preset;
+    for (int i = 0; i < S1Parameter::S1ParameterCount; i++) {
+        preset[i] = (i < count) ? parameters[i] : _kernel->getSynthParameter((S1Parameter)i);
+    }
+    _kernel->loadPreset(preset);
+}
+
+- (void)setSequencerPattern:(const S1SequencerStep *)steps count:(int)count {
+    _kernel->setSequencerPattern(steps, count);
+}
+
+- (void)clearSequencerPattern {
+    _kernel->clearSequencerPattern();
+}
+
 ///auv3
 - (void)setParameter:(AUParameterAddress)address value:(AUValue)value {
-    _kernel->setSynthParameter((S1Parameter)address, value);
+    _kernel->postSynthParameter((S1Parameter)address, value);
 }
 
 ///auv3
@@ -72,10 +100,11 @@
 ///deprecated
 - (void)setParameters:(NSArray<NSNumber*> *)parameters {
     float params[S1Parameter::S1ParameterCount];
-    for (int i = 0; i < parameters.count; i++) {
+    const int count = (int)MIN(parameters.count, (NSUInteger)S1Parameter::S1ParameterCount);
+    for (int i = 0; i < count; i++) {
         params[i] = [parameters[i] floatValue];
     }
-    _kernel->setParameters(params);
+    [self loadPreset:params count:count];
 }
 
 - (void)resetSequencer {
@@ -110,6 +139,17 @@
     _kernel->setBandlimitFrequency(blIndex, frequency);
 }
 
+- (BOOL)setWavetables:(const float *)samples
+          sampleCount:(int)sampleCount
+ bandlimitFrequencies:(const float *)frequencies
+       frequencyCount:(int)frequencyCount {
+    if (sampleCount != S1_NUM_WAVETABLES * S1_FTABLE_SIZE || frequencyCount != S1_NUM_BANDLIMITED_FTABLES) {
+        return NO;
+    }
+    _kernel->setWavetableBank(S1WavetableBank::shared(_kernel->sampleRate(), samples, frequencies));
+    return YES;
+}
+
 - (void)reset {
     _kernel->reset();
 }
@@ -139,10 +179,43 @@
     _kernel->setTuningTableNPO(npo);
 }
 
+- (void)setTuningTable:(const float *)frequencies count:(int)count firstNote:(int)firstNote retune:(BOOL)retune {
+    _kernel->setTuningTable(frequencies, count, firstNote, retune);
+}
 
-- (void)createParameters {
+- (BOOL)setScalaTuning:(NSString *)scl keyboardMapping:(NSString *)kbm retune:(BOOL)retune {
+    return _kernel->setScalaTuning(scl.UTF8String, kbm ? kbm.UTF8String : "", retune);
+}
+
++ (NSArray<NSNumber *> *)scalaMasterSet:(NSString *)scl {
+    const std::optional<S1ScalaScale> scale = S1ParseScalaScale(scl.UTF8String);
+    if (!scale) {
+        return nil;
+    }
+    NSMutableArray<NSNumber *> *masterSet = [NSMutableArray arrayWithObject:@(1.0)];
+    for (int degree = 1; degree < scale->size(); degree++) {
+        [masterSet addObject:@(exp2(scale->degreeCents(degree) / 1200.))];
+    }
+    return masterSet;
+}
+
+- (S1DSPLoad)dspLoad {
+    if (_kernel) {
+        _kernel->readDSPLoad(_dspLoad);
+    }
+    return _dspLoad;
+}
+
+- (void)resetDSPLoad {
+    _kernel->resetDSPLoad();
+}
+
+- (void)setRandomSeed:(UInt32)seed {
+    _kernel->setRandomSeed(seed);
+}
 
-    _messageQueue = [[AEMessageQueue alloc] init];
+
+- (void)createParameters {
 
     self.rampDuration = AKSettings.rampDuration;
     self.defaultFormat = [[AVAudioFormat alloc] initStandardFormatWithSampleRate:AKSettings.sampleRate
@@ -156,6 +229,21 @@
     _kernel->audioUnit = self;
     __block S1DSPKernel *blockKernel = _kernel.get();
     
+    // parameter names are the same for every instance
+    static NSArray<NSString*>* friendlyNames;
+    static NSArray<NSString*>* keyNames;
+    static dispatch_once_t namesOnce;
+    dispatch_once(&namesOnce, ^{
+        NSMutableArray<NSString*>* f = [NSMutableArray arrayWithCapacity:S1Parameter::S1ParameterCount];
+        NSMutableArray<NSString*>* k = [NSMutableArray arrayWithCapacity:S1Parameter::S1ParameterCount];
+        for (const S1ParameterInfo& info : S1ParameterTable::kInfo) {
+            [f addObject:[NSString stringWithCString:info.friendlyName encoding:[NSString defaultCStringEncoding]]];
+            [k addObject:[NSString stringWithCString:info.presetKey encoding:[NSString defaultCStringEncoding]]];
+        }
+        friendlyNames = f;
+        keyNames = k;
+    });
+
     // Create parameter tree
     AudioUnitParameterOptions flags = kAudioUnitParameterFlag_IsWritable | kAudioUnitParameterFlag_IsReadable;
     NSMutableArray<AUParameter*>* tree = [NSMutableArray array];
@@ -165,9 +253,7 @@
         const AUValue maxValue = _kernel->maximum(p);
         const AUValue defaultValue = _kernel->defaultValue(p);
         const AudioUnitParameterUnit unit = _kernel->parameterUnit(p);
-        NSString* friendlyName = [NSString stringWithCString:_kernel->cString(p) encoding:[NSString defaultCStringEncoding]];
-        NSString* keyName = [NSString stringWithCString:_kernel->presetKey(p).c_str() encoding:[NSString defaultCStringEncoding]];
-        AUParameter *param = [AUParameterTree createParameterWithIdentifier:keyName name:friendlyName address:p min:minValue max:maxValue unit:unit unitName:nil flags:flags valueStrings:nil dependentParameters:nil];
+        AUParameter *param = [AUParameterTree createParameterWithIdentifier:keyNames[i] name:friendlyNames[i] address:p min:minValue max:maxValue unit:unit unitName:nil flags:flags valueStrings:nil dependentParameters:nil];
         param.value = defaultValue;
         //_kernel->setSynthParameter(p, defaultValue);
         [tree addObject:param];
@@ -177,12 +263,78 @@
     
     _parameterTree.implementorValueObserver = ^(AUParameter *param, AUValue value) {
         const S1Parameter p = (S1Parameter)param.address;
-        blockKernel->setSynthParameter(p, value);
+        blockKernel->postSynthParameter(p, value);
     };
     _parameterTree.implementorValueProvider = ^(AUParameter *param) {
         const S1Parameter p = (S1Parameter)param.address;
         return blockKernel->getSynthParameter(p);
     };
+
+    // poll DSP state at display rate
+    _statePollLink = [CADisplayLink displayLinkWithTarget:[AEWeakRetainingProxy proxyWithTarget:self]
+                                                 selector:@selector(pollDSPState)];
+    [_statePollLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+}
+
+- (void)dealloc {
+    [_statePollLink invalidate];
+}
+
+// MAIN THREAD: dispatch what changed since the last poll to the S1Protocol delegate
+- (void)pollDSPState {
+    if (!_kernel) {
+        return;
+    }
+
+    // dependent parameters: only the latest change of each
+    DependentParameter dependentParameters[S1Parameter::S1ParameterCount];
+    bool dependentParameterChanged[S1Parameter::S1ParameterCount] = {false};
+    DependentParameter dp;
+    while (_kernel->popDependentParameterChange(dp)) {
+        dependentParameters[dp.parameter] = dp;
+        dependentParameterChanged[dp.parameter] = true;
+    }
+    for (int i = 0; i < S1Parameter::S1ParameterCount; i++) {
+        if (dependentParameterChanged[i]) {
+            [self dependentParameterDidChange:dependentParameters[i]];
+        }
+    }
+    const uint32_t droppedChanges = _kernel->takeDroppedDependentParameterChanges();
+    if (droppedChanges > 0) {
+        NSLog(@"S1AudioUnit: %u dependent parameter changes were dropped by a full queue", droppedChanges);
+    }
+
+#if S1_REALTIME_WATCHDOG_ENABLED
+    // a violation still being recorded is logged by a later poll
+    if (S1RealtimeWatchdogViolationCount() > _loggedViolations) {
+        NSString *report = S1RealtimeWatchdogReport(_loggedViolations, &_loggedViolations);
+        if (report.length > 0) {
+            NSLog(@"%@", report);
+        }
+    }
+#endif
+
+    const S1StateSnapshot previous = _stateSnapshot;
+    if (!_kernel->readStateSnapshot(_stateSnapshot)) {
+        return;
+    }
+
+    // held notes first: the beat counter delegate reads the held note count
+    if (_stateSnapshot.heldNotesVersion != previous.heldNotesVersion) {
+        HeldNotes heldNotes;
+        heldNotes.heldNotesCount = _stateSnapshot.heldNotesCount;
+        for (int i = 0; i < S1_NUM_MIDI_NOTES; i++) {
+            heldNotes.heldNotes[i] = _stateSnapshot.isHeld(i);
+        }
+        [self heldNotesDidChange:heldNotes];
+    }
+    if (_stateSnapshot.beatCounterVersion != previous.beatCounterVersion) {
+        const S1ArpBeatCounter arpBeatCounter = {_stateSnapshot.beatCounter, _stateSnapshot.heldNotesCount};
+        [self arpBeatCounterDidChange:arpBeatCounter];
+    }
+    if (_stateSnapshot.playingNotesVersion != previous.playingNotesVersion) {
+        [self playingNotesDidChange:_stateSnapshot.playingNotes];
+    }
 }
 
 - (BOOL)allocateRenderResourcesAndReturnError:(NSError **)outError {
@@ -190,9 +342,26 @@
         return NO;
     }
     _outputBusBuffer.allocateRenderResources(self.maximumFramesToRender);
+#if S1_REALTIME_WATCHDOG_ENABLED
+    S1RealtimeWatchdogInstall();
+#endif
     if (self.musicalContextBlock) { _musicalContext = self.musicalContextBlock; }
+    if (self.transportStateBlock) { _transportState = self.transportStateBlock; }
     auto parameters = _kernel->parameters;
-    _kernel->init(self.outputBus.format.channelCount, self.outputBus.format.sampleRate);
+
+    // a host renegotiating the format finds the kernel of the previous allocation, reconfigured in place
+    if (_kernel->isInitialized()) {
+        _kernel->reconfigure(self.outputBus.format.channelCount, self.outputBus.format.sampleRate);
+    } else {
+        _kernel->init(self.outputBus.format.channelCount, self.outputBus.format.sampleRate);
+    }
+    if (!_kernel->isInitialized()) {
+        if (outError) {
+            *outError = [NSError errorWithDomain:NSOSStatusErrorDomain code:kAudioUnitErr_FailedInitialization userInfo:nil];
+        }
+        [self deallocateRenderResources];
+        return NO;
+    }
     _kernel->reset();
     _kernel->restoreValues(parameters);
     _kernel->updateWavetableIncrementValuesForCurrentSampleRate();
@@ -204,7 +373,9 @@
     _outputBusBuffer.deallocateRenderResources();
     [super deallocateRenderResources];
     _musicalContext = nil;
-    _kernel->destroy();
+    _transportState = nil;
+
+    // the kernel keeps its DSP objects for the next allocateRenderResources; ~S1DSPKernel destroys them
 }
 
 - (AUInternalRenderBlock)internalRenderBlock {
@@ -219,20 +390,43 @@
                               AURenderPullInputBlock      pullInputBlock) {
         self->_outputBusBuffer.prepareOutputBufferList(outputData, frameCount, true);
         state->setBuffer(outputData);
-        state->processWithEvents(timestamp, frameCount, realtimeEventListHead);
+        state->renderSampleTime = (AUEventSampleTime)timestamp->mSampleTime;
+
+        // host tempo and beat position at the first frame of this render cycle.
+        // Without a moving host transport (standalone, offline rendering) the sequencer runs on its local clock
         double currentTempo;
+        double currentBeatPosition;
+        double hostTempo = 0.0;
+        bool hostTransportIsMoving = false;
         if (self->_musicalContext) {
-            if (self->_musicalContext( &currentTempo, NULL, NULL, NULL, NULL, NULL ) ) {
+            if (self->_musicalContext( &currentTempo, NULL, NULL, &currentBeatPosition, NULL, NULL ) ) {
                 //TODO:AURE: midi clock
-                self->_kernel->handleTempoSetting(currentTempo);
+                hostTempo = currentTempo;
+                AUHostTransportStateFlags transportStateFlags = 0;
+                if (self->_transportState && self->_transportState(&transportStateFlags, NULL, NULL, NULL)) {
+                    hostTransportIsMoving = (transportStateFlags & AUHostTransportStateMoving) != 0;
+                }
+                state->hostBeatPosition = currentBeatPosition;
             }
         }
+        state->handleTempoSetting(hostTempo);
+        state->hostTransportIsMoving = hostTransportIsMoving;
+
+        state->beginRenderCycle();
+#if S1_REALTIME_WATCHDOG_ENABLED
+        S1RealtimeWatchdogEnter();
+#endif
+        state->processWithEvents(timestamp, frameCount, realtimeEventListHead);
+#if S1_REALTIME_WATCHDOG_ENABLED
+        S1RealtimeWatchdogExit();
+#endif
+        state->endRenderCycle(frameCount);
         return noErr;
     };
 }
 
 
-// passthroughs for S1Protocol called by DSP on main thread
+// passthroughs for S1Protocol called by pollDSPState on main thread
 - (void)dependentParameterDidChange:(DependentParameter)param {
     [_s1Delegate dependentParameterDidChange:param];
 }
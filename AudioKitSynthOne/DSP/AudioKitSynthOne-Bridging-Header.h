@@ -11,6 +11,9 @@
 #import "S1AudioUnit.h"
 #import "S1Parameter.h"
 #import "AKSynthOneRate.h"
+#import "S1PresetIndex.h"
+#import "S1RealtimeWatchdog.h"
+#import "S1BatchRenderer.h"
 #if !TARGET_OS_MACCATALYST
 #import "Audiobus.h"
 #endif
@@ -0,0 +1,83 @@
+//
+//  S1BatchRenderer.h
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Faster than real time rendering of preset x phrase jobs to audio files: a new kernel per job, on one worker
+//  thread per core, all reading one shared wavetable bank.
+
+#pragma once
+
+#import <Foundation/Foundation.h>
+#import "S1Parameter.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, S1BatchRenderFileFormat) {
+    S1BatchRenderFileFormatPCM,     // 32-bit float CAF
+    S1BatchRenderFileFormatAAC      // AAC in an M4A file
+};
+
+// note on, or note off if velocity is 0
+typedef struct S1BatchRenderEvent {
+    double time;                    // seconds from the start of the render
+    uint8_t noteNumber;
+    uint8_t velocity;
+} S1BatchRenderEvent;
+
+// notes played by a job; immutable, so jobs running in parallel can share it
+@interface S1BatchRenderPhrase : NSObject
+
+// duration: seconds rendered, including the release tail after the last event
+- (instancetype)initWithEvents:(const S1BatchRenderEvent *)events count:(NSInteger)count duration:(double)duration;
+
+// note events of every track of a standard MIDI file at its tempo map, then tail seconds; nil if unreadable
+- (nullable instancetype)initWithContentsOfMIDIFile:(NSURL *)url tail:(double)tail;
+
+@property (nonatomic, readonly) double duration;
+@property (nonatomic, readonly) NSInteger count;
+
+- (S1BatchRenderEvent)eventAtIndex:(NSInteger)index;
+
+@end
+
+@interface S1BatchRenderJob : NSObject
+
+// parameters: S1ParameterCount values; NAN keeps a parameter's default.  Renders with seed passed to setRandomSeed
+- (instancetype)initWithParameters:(const float *)parameters
+                            phrase:(S1BatchRenderPhrase *)phrase
+                         outputURL:(NSURL *)outputURL
+                              seed:(uint32_t)seed;
+
+@property (nonatomic, readonly) S1BatchRenderPhrase *phrase;
+@property (nonatomic, readonly) NSURL *outputURL;
+@property (nonatomic, readonly) uint32_t seed;
+
+@end
+
+@interface S1BatchRenderer : NSObject
+
+// wavetables: S1_NUM_WAVEFORMS * S1_NUM_BANDLIMITED_FTABLES tables of 4096 samples in table index order, as
+// AKSynthOne loads them.  bandlimitFrequencies: S1_NUM_BANDLIMITED_FTABLES.  nil if a count differs
+- (nullable instancetype)initWithWavetables:(const float *)wavetables
+                                sampleCount:(NSInteger)sampleCount
+                       bandlimitFrequencies:(const float *)bandlimitFrequencies
+                             frequencyCount:(NSInteger)frequencyCount
+                                 sampleRate:(double)sampleRate;
+
+@property (nonatomic, readonly) double sampleRate;
+
+// worker threads of renderJobs; defaults to the active processor count
+@property (nonatomic) NSInteger workerCount;
+
+// Render jobs on workerCount threads, writing stereo files of format.  Returns at once; completion runs on the
+// main queue with the indexes of the jobs whose file could not be written.  One batch at a time
+- (void)renderJobs:(NSArray<S1BatchRenderJob *> *)jobs
+            format:(S1BatchRenderFileFormat)format
+        completion:(void (^)(NSIndexSet *failedJobs))completion;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,341 @@
+//
+//  S1BatchRenderer.mm
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+
+#import "S1BatchRenderer.h"
+#import <AudioToolbox/AudioToolbox.h>
+#import <algorithm>
+#import <atomic>
+#import <cmath>
+#import <memory>
+#import <vector>
+#import "S1DSPKernel.hpp"
+#import "S1WavetableBank.hpp"
+
+#define S1_BATCH_CHANNEL_COUNT (2)
+#define S1_BATCH_FRAMES_PER_RENDER (512)
+
+// MARK: - S1BatchRenderPhrase
+
+@implementation S1BatchRenderPhrase {
+    std::vector<S1BatchRenderEvent> _events;
+}
+
+- (instancetype)initWithEvents:(const S1BatchRenderEvent *)events count:(NSInteger)count duration:(double)duration {
+    self = [super init];
+    if (self) {
+        _events.assign(events, events + count);
+
+        // a note off before a note on at the same time, so a repeated note restarts
+        std::stable_sort(_events.begin(), _events.end(), [](const S1BatchRenderEvent &a, const S1BatchRenderEvent &b) {
+            return a.time < b.time || (a.time == b.time && a.velocity == 0 && b.velocity != 0);
+        });
+        _duration = duration;
+    }
+    return self;
+}
+
+- (nullable instancetype)initWithContentsOfMIDIFile:(NSURL *)url tail:(double)tail {
+    MusicSequence sequence;
+    if (NewMusicSequence(&sequence) != noErr) {
+        return nil;
+    }
+    if (MusicSequenceFileLoad(sequence, (__bridge CFURLRef)url, kMusicSequenceFile_MIDIType, 0) != noErr) {
+        DisposeMusicSequence(sequence);
+        return nil;
+    }
+    std::vector<S1BatchRenderEvent> events;
+    double end = 0.;
+    UInt32 trackCount = 0;
+    MusicSequenceGetTrackCount(sequence, &trackCount);
+    for (UInt32 t = 0; t < trackCount; t++) {
+        MusicTrack track;
+        MusicEventIterator iterator;
+        if (MusicSequenceGetIndTrack(sequence, t, &track) != noErr || NewMusicEventIterator(track, &iterator) != noErr) {
+            continue;
+        }
+        Boolean hasEvent = false;
+        MusicEventIteratorHasCurrentEvent(iterator, &hasEvent);
+        while (hasEvent) {
+            MusicTimeStamp beat;
+            MusicEventType type;
+            const void *data;
+            UInt32 size;
+            MusicEventIteratorGetEventInfo(iterator, &beat, &type, &data, &size);
+            if (type == kMusicEventType_MIDINoteMessage) {
+                const MIDINoteMessage *note = (const MIDINoteMessage *)data;
+                Float64 on = 0.;
+                Float64 off = 0.;
+                MusicSequenceGetSecondsForBeats(sequence, beat, &on);
+                MusicSequenceGetSecondsForBeats(sequence, beat + note->duration, &off);
+                events.push_back({on, note->note, (uint8_t)std::max<int>(note->velocity, 1)});
+                events.push_back({off, note->note, 0});
+                end = std::max(end, off);
+            }
+            MusicEventIteratorNextEvent(iterator);
+            MusicEventIteratorHasCurrentEvent(iterator, &hasEvent);
+        }
+        DisposeMusicEventIterator(iterator);
+    }
+    DisposeMusicSequence(sequence);
+    return [self initWithEvents:events.data() count:events.size() duration:end + tail];
+}
+
+- (NSInteger)count {
+    return _events.size();
+}
+
+- (S1BatchRenderEvent)eventAtIndex:(NSInteger)index {
+    return _events[index];
+}
+
+@end
+
+// MARK: - S1BatchRenderJob
+
+@interface S1BatchRenderJob ()
+- (const float *)parameters NS_RETURNS_INNER_POINTER;
+@end
+
+@implementation S1BatchRenderJob {
+    DSPParameters _parameters;
+}
+
+- (instancetype)initWithParameters:(const float *)parameters
+                            phrase:(S1BatchRenderPhrase *)phrase
+                         outputURL:(NSURL *)outputURL
+                              seed:(uint32_t)seed {
+    self = [super init];
+    if (self) {
+        std::copy(parameters, parameters + S1Parameter::S1ParameterCount, _parameters.begin());
+        _phrase = phrase;
+        _outputURL = [outputURL copy];
+        _seed = seed;
+    }
+    return self;
+}
+
+- (const float *)parameters {
+    return _parameters.data();
+}
+
+@end
+
+// MARK: - Worker
+
+// Renders jobs one after another on one thread, each with a new kernel reading the shared wavetable bank
+class S1BatchWorker {
+
+public:
+
+    S1BatchWorker(const S1BatchWorker&) = delete;
+
+    S1BatchWorker(std::shared_ptr<const S1WavetableBank> bank) :
+        mSampleRate(bank->sampleRate()),
+        mBank(std::move(bank)) {
+        for (std::vector<float> &samples : mSamples) {
+            samples.resize(S1_BATCH_FRAMES_PER_RENDER);
+        }
+    }
+
+    bool render(S1BatchRenderJob *job, S1BatchRenderFileFormat format) {
+        // a kernel of its own per job, so no DSP state of an earlier job carries over and the output of a job does
+        // not depend on which jobs its worker rendered before
+        std::unique_ptr<S1DSPKernel> newKernel = std::make_unique<S1DSPKernel>(S1_BATCH_CHANNEL_COUNT, mSampleRate);
+        S1DSPKernel &kernel = *newKernel;
+        if (!kernel.isInitialized()) {
+            return false;
+        }
+        kernel.publishesDependentParameterChanges = false;
+        kernel.setWavetableBank(mBank);
+        kernel.setRandomSeed(job.seed);
+        const float *parameters = job.parameters;
+        DSPParameters preset;
+        for (int i = 0; i < S1Parameter::S1ParameterCount; i++) {
+            preset[i] = std::isnan(parameters[i]) ? kernel.defaultValue((S1Parameter)i) : parameters[i];
+        }
+        kernel.loadPreset(preset);
+
+        ExtAudioFileRef file = createFile(job.outputURL, format);
+        if (!file) {
+            return false;
+        }
+
+        // the phrase as the host would deliver it, linked per render cycle below
+        S1BatchRenderPhrase *phrase = job.phrase;
+        std::vector<AURenderEvent> events(phrase.count);
+        for (NSInteger i = 0; i < phrase.count; i++) {
+            const S1BatchRenderEvent event = [phrase eventAtIndex:i];
+            AUMIDIEvent &midi = events[i].MIDI;
+            midi = {};
+            midi.eventSampleTime = (AUEventSampleTime)llround(event.time * mSampleRate);
+            midi.eventType = AURenderEventMIDI;
+            midi.length = 3;
+            midi.data[0] = event.velocity > 0 ? 0x90 : 0x80;
+            midi.data[1] = event.noteNumber;
+            midi.data[2] = event.velocity;
+        }
+
+        const AUEventSampleTime frameTotal = (AUEventSampleTime)llround(phrase.duration * mSampleRate);
+        AudioTimeStamp timestamp = {};
+        timestamp.mFlags = kAudioTimeStampSampleTimeValid;
+        size_t nextEvent = 0;
+        bool succeeded = true;
+        for (AUEventSampleTime frame = 0; frame < frameTotal && succeeded; frame += S1_BATCH_FRAMES_PER_RENDER) {
+            const AUAudioFrameCount frameCount =
+                (AUAudioFrameCount)std::min<AUEventSampleTime>(S1_BATCH_FRAMES_PER_RENDER, frameTotal - frame);
+            const size_t firstEvent = nextEvent;
+            while (nextEvent < events.size() && events[nextEvent].head.eventSampleTime < frame + frameCount) {
+                events[nextEvent].head.next = nullptr;
+                if (nextEvent > firstEvent) {
+                    events[nextEvent - 1].head.next = &events[nextEvent];
+                }
+                nextEvent++;
+            }
+            for (int channel = 0; channel < S1_BATCH_CHANNEL_COUNT; channel++) {
+                mBufferList.list.mBuffers[channel].mNumberChannels = 1;
+                mBufferList.list.mBuffers[channel].mDataByteSize = frameCount * sizeof(float);
+                mBufferList.list.mBuffers[channel].mData = mSamples[channel].data();
+            }
+            mBufferList.list.mNumberBuffers = S1_BATCH_CHANNEL_COUNT;
+            timestamp.mSampleTime = frame;
+
+            kernel.setBuffer(&mBufferList.list);
+            kernel.renderSampleTime = frame;
+            kernel.beginRenderCycle();
+            kernel.processWithEvents(&timestamp, frameCount, nextEvent > firstEvent ? &events[firstEvent] : nullptr);
+            kernel.endRenderCycle(frameCount);
+            succeeded = ExtAudioFileWrite(file, frameCount, &mBufferList.list) == noErr;
+        }
+        succeeded = ExtAudioFileDispose(file) == noErr && succeeded;
+
+        // startNote and stopNote replace the held note arrays; AEManagedValue frees the old ones from a timer
+        // on the run loop of this thread
+        CFRunLoopRunInMode(kCFRunLoopDefaultMode, 0, true);
+        return succeeded;
+    }
+
+private:
+
+    ExtAudioFileRef createFile(NSURL *url, S1BatchRenderFileFormat format) {
+        AudioStreamBasicDescription fileFormat = {};
+        fileFormat.mSampleRate = mSampleRate;
+        fileFormat.mChannelsPerFrame = S1_BATCH_CHANNEL_COUNT;
+        AudioFileTypeID fileType;
+        if (format == S1BatchRenderFileFormatAAC) {
+            fileType = kAudioFileM4AType;
+            fileFormat.mFormatID = kAudioFormatMPEG4AAC;
+        } else {
+            fileType = kAudioFileCAFType;
+            fileFormat.mFormatID = kAudioFormatLinearPCM;
+            fileFormat.mFormatFlags = kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked;
+            fileFormat.mBitsPerChannel = 32;
+            fileFormat.mFramesPerPacket = 1;
+            fileFormat.mBytesPerFrame = S1_BATCH_CHANNEL_COUNT * sizeof(float);
+            fileFormat.mBytesPerPacket = fileFormat.mBytesPerFrame;
+        }
+        ExtAudioFileRef file = nullptr;
+        if (ExtAudioFileCreateWithURL((__bridge CFURLRef)url, fileType, &fileFormat, nullptr,
+                                      kAudioFileFlags_EraseFile, &file) != noErr) {
+            return nullptr;
+        }
+
+        // the hardware encoder is one per device; the software one runs on every worker at once
+        if (format == S1BatchRenderFileFormatAAC) {
+            UInt32 codecManufacturer = kAppleSoftwareAudioCodecManufacturer;
+            ExtAudioFileSetProperty(file, kExtAudioFileProperty_CodecManufacturer, sizeof(codecManufacturer), &codecManufacturer);
+        }
+
+        // the kernel renders deinterleaved float
+        AudioStreamBasicDescription clientFormat = {};
+        clientFormat.mSampleRate = mSampleRate;
+        clientFormat.mFormatID = kAudioFormatLinearPCM;
+        clientFormat.mFormatFlags = kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked | kAudioFormatFlagIsNonInterleaved;
+        clientFormat.mBitsPerChannel = 32;
+        clientFormat.mChannelsPerFrame = S1_BATCH_CHANNEL_COUNT;
+        clientFormat.mFramesPerPacket = 1;
+        clientFormat.mBytesPerFrame = sizeof(float);
+        clientFormat.mBytesPerPacket = sizeof(float);
+        if (ExtAudioFileSetProperty(file, kExtAudioFileProperty_ClientDataFormat, sizeof(clientFormat), &clientFormat) != noErr) {
+            ExtAudioFileDispose(file);
+            return nullptr;
+        }
+        return file;
+    }
+
+    const double mSampleRate;
+    const std::shared_ptr<const S1WavetableBank> mBank;
+    std::array<std::vector<float>, S1_BATCH_CHANNEL_COUNT> mSamples;
+
+    // AudioBufferList declares one buffer
+    struct {
+        AudioBufferList list;
+        AudioBuffer additionalBuffers[S1_BATCH_CHANNEL_COUNT - 1];
+    } mBufferList;
+};
+
+// MARK: - S1BatchRenderer
+
+@implementation S1BatchRenderer {
+    std::shared_ptr<const S1WavetableBank> _wavetableBank;
+}
+
+- (nullable instancetype)initWithWavetables:(const float *)wavetables
+                                sampleCount:(NSInteger)sampleCount
+                       bandlimitFrequencies:(const float *)bandlimitFrequencies
+                             frequencyCount:(NSInteger)frequencyCount
+                                 sampleRate:(double)sampleRate {
+    if (sampleCount != S1_NUM_WAVETABLES * S1_FTABLE_SIZE || frequencyCount != S1_NUM_BANDLIMITED_FTABLES) {
+        return nil;
+    }
+    self = [super init];
+    if (self) {
+        _wavetableBank = S1WavetableBank::shared(sampleRate, wavetables, bandlimitFrequencies);
+        _sampleRate = sampleRate;
+        _workerCount = [NSProcessInfo processInfo].activeProcessorCount;
+    }
+    return self;
+}
+
+- (void)renderJobs:(NSArray<S1BatchRenderJob *> *)jobs
+            format:(S1BatchRenderFileFormat)format
+        completion:(void (^)(NSIndexSet *failedJobs))completion {
+    NSArray<S1BatchRenderJob *> *batch = [jobs copy];
+    std::shared_ptr<const S1WavetableBank> bank = _wavetableBank;
+    const size_t workerCount = (size_t)std::max<NSInteger>(1, std::min<NSInteger>(_workerCount, batch.count));
+    dispatch_queue_t queue = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+
+    dispatch_async(queue, ^{
+        // workers take the next job until none is left; each writes only the failure flag of its jobs
+        std::atomic<NSInteger> nextJob {0};
+        std::vector<char> failed(batch.count, 0);
+        std::atomic<NSInteger> *nextJobPointer = &nextJob;
+        char *failedPointer = failed.data();
+        dispatch_apply(workerCount, queue, ^(size_t) {
+            @autoreleasepool {
+                S1BatchWorker worker(bank);
+                for (NSInteger i = nextJobPointer->fetch_add(1); i < (NSInteger)batch.count; i = nextJobPointer->fetch_add(1)) {
+                    @autoreleasepool {
+                        failedPointer[i] = !worker.render(batch[i], format);
+                    }
+                }
+            }
+        });
+
+        NSMutableIndexSet *failedJobs = [NSMutableIndexSet indexSet];
+        for (NSUInteger i = 0; i < batch.count; i++) {
+            if (failed[i]) {
+                [failedJobs addIndex:i];
+            }
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(failedJobs);
+        });
+    });
+}
+
+@end
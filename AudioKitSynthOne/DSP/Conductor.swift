@@ -216,6 +216,19 @@ class Conductor: S1Protocol {
             try AudioKit.start()
             #if DEBUG
             AKLog("AudioKit Started")
+            if ProcessInfo.processInfo.arguments.contains(AKSynthOne.realtimeSafetyCheckArgument) {
+                synth.runRealtimeSafetyCheck { report in
+                    AKLog(report.isEmpty ? "Realtime safety check passed" : report)
+                }
+            }
+            if let mode = UserDefaults.standard.string(forKey: AKSynthOne.goldenOutputModeKey) {
+                let toleranceKey = AKSynthOne.goldenOutputToleranceKey
+                let tolerance = UserDefaults.standard.object(forKey: toleranceKey) != nil ?
+                    UserDefaults.standard.float(forKey: toleranceKey) : AKSynthOne.goldenOutputDefaultTolerance
+                AKSynthOne.runGoldenOutputCheck(record: mode == "record", tolerance: tolerance) { report, _ in
+                    AKLog(report)
+                }
+            }
             #endif
         } catch {
             AKLog("AudioKit did not start! \(error)")
@@ -351,4 +364,9 @@ extension Conductor: S1TuningTable {
 
         return Double( synth.getTuningTableFrequency(index) )
     }
+
+    func setTuningTable(_ frequencies: [Double], firstNote: Int, retune: Bool) {
+
+        synth.setTuningTable(frequencies, firstNote: firstNote, retune: retune)
+    }
 }
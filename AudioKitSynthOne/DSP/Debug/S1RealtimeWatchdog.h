@@ -0,0 +1,46 @@
+//
+//  S1RealtimeWatchdog.h
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  DEBUG builds: reports allocation, locking and Objective-C object creation on the render thread.
+//  Release builds compile the watchdog to nothing.
+
+#pragma once
+
+#import <Foundation/Foundation.h>
+
+#if DEBUG
+#define S1_REALTIME_WATCHDOG_ENABLED (1)
+#else
+#define S1_REALTIME_WATCHDOG_ENABLED (0)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MAIN THREAD: hook the malloc zones, and rebind the lock and Objective-C functions of the app and its frameworks.
+// Idempotent
+void S1RealtimeWatchdogInstall(void);
+
+// RENDER THREAD: hooked calls on this thread between Enter and Exit are violations
+void S1RealtimeWatchdogEnter(void);
+void S1RealtimeWatchdogExit(void);
+
+// distinct call stacks recorded so far, at most S1_REALTIME_WATCHDOG_MAX_VIOLATIONS
+NSInteger S1RealtimeWatchdogViolationCount(void);
+
+// MAIN THREAD: symbolicated call stacks of the violations from index firstViolation on, with their number of occurrences.
+// Stops at the first violation the render thread is still recording; nextViolation, if not NULL, receives its index,
+// where the next report starts
+NSString *S1RealtimeWatchdogReport(NSInteger firstViolation, NSInteger *nextViolation);
+
+// MAIN THREAD: forget the recorded violations; call while not rendering
+void S1RealtimeWatchdogReset(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,452 @@
+//
+//  S1RealtimeWatchdog.mm
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+
+#import "S1RealtimeWatchdog.h"
+
+#if S1_REALTIME_WATCHDOG_ENABLED
+
+#import <algorithm>
+#import <atomic>
+#import <cstring>
+#import <dlfcn.h>
+#import <execinfo.h>
+#import <mach/mach.h>
+#import <mach-o/dyld.h>
+#import <mach-o/loader.h>
+#import <mach-o/nlist.h>
+#import <malloc/malloc.h>
+#import <os/lock.h>
+#import <pthread.h>
+
+#define S1_REALTIME_WATCHDOG_MAX_VIOLATIONS (64)
+#define S1_REALTIME_WATCHDOG_MAX_FRAMES (32)
+#define S1_REALTIME_WATCHDOG_MAX_ZONES (16)
+
+#ifndef MH_DYLIB_IN_CACHE
+#define MH_DYLIB_IN_CACHE (0x80000000)
+#endif
+
+// MARK: - Violations
+
+// one distinct call stack; written once by the render thread that claims it, then only its count changes
+struct S1RealtimeViolation {
+    const char *function;
+    int frameCount;
+    void *frames[S1_REALTIME_WATCHDOG_MAX_FRAMES];
+    std::atomic<uint32_t> occurrences;
+    std::atomic<bool> isRecorded;
+};
+
+static S1RealtimeViolation sViolations[S1_REALTIME_WATCHDOG_MAX_VIOLATIONS];
+static std::atomic<int> sClaimedViolations {0};
+static std::atomic<bool> sIsInstalled {false};
+
+// set on a thread between Enter and Exit.  Thread-specific data rather than thread_local: the first access of a
+// thread_local allocates, which would recurse into the malloc hooks
+static pthread_key_t sRealtimeKey;
+static void *const kRealtime = (void *)1;
+
+static inline bool isRealtimeThread() {
+    return sIsInstalled.load(std::memory_order_relaxed) && pthread_getspecific(sRealtimeKey) == kRealtime;
+}
+
+// RENDER THREAD: backtrace() walks the stack without allocating
+static void recordViolation(const char *function) {
+
+    // nothing below is reported again
+    pthread_setspecific(sRealtimeKey, nullptr);
+
+    void *frames[S1_REALTIME_WATCHDOG_MAX_FRAMES];
+    const int frameCount = backtrace(frames, S1_REALTIME_WATCHDOG_MAX_FRAMES);
+    const int claimed = std::min(sClaimedViolations.load(std::memory_order_acquire), S1_REALTIME_WATCHDOG_MAX_VIOLATIONS);
+    bool isKnown = false;
+    for (int i = 0; i < claimed && !isKnown; i++) {
+        S1RealtimeViolation &violation = sViolations[i];
+        if (violation.isRecorded.load(std::memory_order_acquire) && violation.frameCount == frameCount &&
+            memcmp(violation.frames, frames, frameCount * sizeof(void *)) == 0) {
+            violation.occurrences.fetch_add(1, std::memory_order_relaxed);
+            isKnown = true;
+        }
+    }
+    if (!isKnown) {
+        const int i = sClaimedViolations.fetch_add(1, std::memory_order_acq_rel);
+        if (i < S1_REALTIME_WATCHDOG_MAX_VIOLATIONS) {
+            S1RealtimeViolation &violation = sViolations[i];
+            violation.function = function;
+            violation.frameCount = frameCount;
+            memcpy(violation.frames, frames, frameCount * sizeof(void *));
+            violation.occurrences.store(1, std::memory_order_relaxed);
+            violation.isRecorded.store(true, std::memory_order_release);
+        }
+    }
+
+    pthread_setspecific(sRealtimeKey, kRealtime);
+}
+
+#define S1_REALTIME_CHECK(function) \
+    if (isRealtimeThread()) { \
+        recordViolation(function); \
+    }
+
+// MARK: - malloc zones
+
+// the original functions of each hooked zone
+struct S1ZoneFunctions {
+    malloc_zone_t *zone;
+    void *(*malloc)(malloc_zone_t *zone, size_t size);
+    void *(*calloc)(malloc_zone_t *zone, size_t count, size_t size);
+    void *(*valloc)(malloc_zone_t *zone, size_t size);
+    void *(*realloc)(malloc_zone_t *zone, void *pointer, size_t size);
+    void (*free)(malloc_zone_t *zone, void *pointer);
+    void *(*memalign)(malloc_zone_t *zone, size_t alignment, size_t size);
+    void (*free_definite_size)(malloc_zone_t *zone, void *pointer, size_t size);
+};
+
+static S1ZoneFunctions sZones[S1_REALTIME_WATCHDOG_MAX_ZONES];
+static int sZoneCount = 0;
+
+static const S1ZoneFunctions &original(malloc_zone_t *zone) {
+    for (int i = 1; i < sZoneCount; i++) {
+        if (sZones[i].zone == zone) {
+            return sZones[i];
+        }
+    }
+    return sZones[0];
+}
+
+static void *watchdogMalloc(malloc_zone_t *zone, size_t size) {
+    S1_REALTIME_CHECK("malloc");
+    return original(zone).malloc(zone, size);
+}
+
+static void *watchdogCalloc(malloc_zone_t *zone, size_t count, size_t size) {
+    S1_REALTIME_CHECK("calloc");
+    return original(zone).calloc(zone, count, size);
+}
+
+static void *watchdogValloc(malloc_zone_t *zone, size_t size) {
+    S1_REALTIME_CHECK("valloc");
+    return original(zone).valloc(zone, size);
+}
+
+static void *watchdogRealloc(malloc_zone_t *zone, void *pointer, size_t size) {
+    S1_REALTIME_CHECK("realloc");
+    return original(zone).realloc(zone, pointer, size);
+}
+
+static void watchdogFree(malloc_zone_t *zone, void *pointer) {
+    S1_REALTIME_CHECK("free");
+    original(zone).free(zone, pointer);
+}
+
+static void *watchdogMemalign(malloc_zone_t *zone, size_t alignment, size_t size) {
+    S1_REALTIME_CHECK("memalign");
+    return original(zone).memalign(zone, alignment, size);
+}
+
+static void watchdogFreeDefiniteSize(malloc_zone_t *zone, void *pointer, size_t size) {
+    S1_REALTIME_CHECK("free");
+    original(zone).free_definite_size(zone, pointer, size);
+}
+
+static void hookMallocZones() {
+    vm_address_t *zones = nullptr;
+    unsigned int zoneCount = 0;
+    if (malloc_get_all_zones(mach_task_self(), nullptr, &zones, &zoneCount) != KERN_SUCCESS) {
+        return;
+    }
+    for (unsigned int i = 0; i < zoneCount && sZoneCount < S1_REALTIME_WATCHDOG_MAX_ZONES; i++) {
+        malloc_zone_t *zone = (malloc_zone_t *)zones[i];
+        S1ZoneFunctions &functions = sZones[sZoneCount];
+        functions = {zone, zone->malloc, zone->calloc, zone->valloc, zone->realloc, zone->free,
+            zone->version >= 5 ? zone->memalign : nullptr, zone->version >= 6 ? zone->free_definite_size : nullptr};
+
+        // zones are read-only once registered
+        if (vm_protect(mach_task_self(), (vm_address_t)zone, sizeof(malloc_zone_t), 0,
+                       VM_PROT_READ | VM_PROT_WRITE) != KERN_SUCCESS) {
+            continue;
+        }
+        zone->malloc = watchdogMalloc;
+        zone->calloc = watchdogCalloc;
+        zone->valloc = watchdogValloc;
+        zone->realloc = watchdogRealloc;
+        zone->free = watchdogFree;
+        if (functions.memalign) {
+            zone->memalign = watchdogMemalign;
+        }
+        if (functions.free_definite_size) {
+            zone->free_definite_size = watchdogFreeDefiniteSize;
+        }
+        vm_protect(mach_task_self(), (vm_address_t)zone, sizeof(malloc_zone_t), 0, VM_PROT_READ);
+        sZoneCount++;
+    }
+}
+
+// MARK: - Locks and Objective-C
+
+// Objective-C objects are void * so ARC leaves the arguments alone.  objc_msgSend itself cannot be rebound without an
+// assembly trampoline; the allocations a message makes are caught by the malloc hooks
+static int (*sPthreadMutexLock)(pthread_mutex_t *);
+static int (*sPthreadRwlockRdlock)(pthread_rwlock_t *);
+static int (*sPthreadRwlockWrlock)(pthread_rwlock_t *);
+static int (*sPthreadCondWait)(pthread_cond_t *, pthread_mutex_t *);
+static void (*sOsUnfairLockLock)(os_unfair_lock_t);
+static kern_return_t (*sSemaphoreWait)(semaphore_t);
+static void (*sMutexLock)(void *);
+static void (*sRecursiveMutexLock)(void *);
+static void *(*sObjcAlloc)(void *);
+static void *(*sObjcAllocInit)(void *);
+static void *(*sObjcOptNew)(void *);
+static void *(*sObjcAutorelease)(void *);
+static void *(*sObjcAutoreleasePoolPush)(void);
+
+static int watchdogPthreadMutexLock(pthread_mutex_t *mutex) {
+    S1_REALTIME_CHECK("pthread_mutex_lock");
+    return sPthreadMutexLock(mutex);
+}
+
+static int watchdogPthreadRwlockRdlock(pthread_rwlock_t *lock) {
+    S1_REALTIME_CHECK("pthread_rwlock_rdlock");
+    return sPthreadRwlockRdlock(lock);
+}
+
+static int watchdogPthreadRwlockWrlock(pthread_rwlock_t *lock) {
+    S1_REALTIME_CHECK("pthread_rwlock_wrlock");
+    return sPthreadRwlockWrlock(lock);
+}
+
+static int watchdogPthreadCondWait(pthread_cond_t *condition, pthread_mutex_t *mutex) {
+    S1_REALTIME_CHECK("pthread_cond_wait");
+    return sPthreadCondWait(condition, mutex);
+}
+
+static void watchdogOsUnfairLockLock(os_unfair_lock_t lock) {
+    S1_REALTIME_CHECK("os_unfair_lock_lock");
+    sOsUnfairLockLock(lock);
+}
+
+static kern_return_t watchdogSemaphoreWait(semaphore_t semaphore) {
+    S1_REALTIME_CHECK("semaphore_wait");
+    return sSemaphoreWait(semaphore);
+}
+
+static void watchdogMutexLock(void *mutex) {
+    S1_REALTIME_CHECK("std::mutex::lock");
+    sMutexLock(mutex);
+}
+
+static void watchdogRecursiveMutexLock(void *mutex) {
+    S1_REALTIME_CHECK("std::recursive_mutex::lock");
+    sRecursiveMutexLock(mutex);
+}
+
+static void *watchdogObjcAlloc(void *cls) {
+    S1_REALTIME_CHECK("objc_alloc");
+    return sObjcAlloc(cls);
+}
+
+static void *watchdogObjcAllocInit(void *cls) {
+    S1_REALTIME_CHECK("objc_alloc_init");
+    return sObjcAllocInit(cls);
+}
+
+static void *watchdogObjcOptNew(void *cls) {
+    S1_REALTIME_CHECK("objc_opt_new");
+    return sObjcOptNew(cls);
+}
+
+static void *watchdogObjcAutorelease(void *object) {
+    S1_REALTIME_CHECK("objc_autorelease");
+    return sObjcAutorelease(object);
+}
+
+static void *watchdogObjcAutoreleasePoolPush(void) {
+    S1_REALTIME_CHECK("objc_autoreleasePoolPush");
+    return sObjcAutoreleasePoolPush();
+}
+
+struct S1Rebinding {
+    const char *symbol;     // as in the symbol table, with the leading underscore
+    void *replacement;
+    void **original;
+};
+
+static S1Rebinding sRebindings[] = {
+    {"_pthread_mutex_lock", (void *)watchdogPthreadMutexLock, (void **)&sPthreadMutexLock},
+    {"_pthread_rwlock_rdlock", (void *)watchdogPthreadRwlockRdlock, (void **)&sPthreadRwlockRdlock},
+    {"_pthread_rwlock_wrlock", (void *)watchdogPthreadRwlockWrlock, (void **)&sPthreadRwlockWrlock},
+    {"_pthread_cond_wait", (void *)watchdogPthreadCondWait, (void **)&sPthreadCondWait},
+    {"_os_unfair_lock_lock", (void *)watchdogOsUnfairLockLock, (void **)&sOsUnfairLockLock},
+    {"_semaphore_wait", (void *)watchdogSemaphoreWait, (void **)&sSemaphoreWait},
+    {"__ZNSt3__15mutex4lockEv", (void *)watchdogMutexLock, (void **)&sMutexLock},
+    {"__ZNSt3__115recursive_mutex4lockEv", (void *)watchdogRecursiveMutexLock, (void **)&sRecursiveMutexLock},
+    {"_objc_alloc", (void *)watchdogObjcAlloc, (void **)&sObjcAlloc},
+    {"_objc_alloc_init", (void *)watchdogObjcAllocInit, (void **)&sObjcAllocInit},
+    {"_objc_opt_new", (void *)watchdogObjcOptNew, (void **)&sObjcOptNew},
+    {"_objc_autorelease", (void *)watchdogObjcAutorelease, (void **)&sObjcAutorelease},
+    {"_objc_autoreleasePoolPush", (void *)watchdogObjcAutoreleasePoolPush, (void **)&sObjcAutoreleasePoolPush},
+};
+
+// point the symbol pointers of one section at the replacements
+static void rebindSection(const section_64 *section, intptr_t slide, const nlist_64 *symbols, const char *strings,
+                          const uint32_t *indirectSymbols) {
+    const uint32_t *symbolIndices = indirectSymbols + section->reserved1;
+    void **bindings = (void **)(slide + section->addr);
+    const size_t count = section->size / sizeof(void *);
+    bool isWritable = false;
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t symbolIndex = symbolIndices[i];
+        if (symbolIndex & (INDIRECT_SYMBOL_ABS | INDIRECT_SYMBOL_LOCAL)) {
+            continue;
+        }
+        const char *name = strings + symbols[symbolIndex].n_un.n_strx;
+        for (const S1Rebinding &rebinding : sRebindings) {
+            if (*rebinding.original == nullptr || strcmp(name, rebinding.symbol) != 0) {
+                continue;
+            }
+            if (!isWritable) {
+                if (vm_protect(mach_task_self(), (vm_address_t)bindings, section->size, 0,
+                               VM_PROT_READ | VM_PROT_WRITE | VM_PROT_COPY) != KERN_SUCCESS) {
+                    return;
+                }
+                isWritable = true;
+            }
+            bindings[i] = rebinding.replacement;
+            break;
+        }
+    }
+}
+
+// dyld callback for every image, loaded now or later.  Images in the shared cache are left alone: their calls
+// to each other don't go through symbol pointers, and their pointers may be signed
+static void rebindImage(const struct mach_header *header, intptr_t slide) {
+    if (header->magic != MH_MAGIC_64 || (header->flags & MH_DYLIB_IN_CACHE)) {
+        return;
+    }
+    const segment_command_64 *linkedit = nullptr;
+    const symtab_command *symtab = nullptr;
+    const dysymtab_command *dysymtab = nullptr;
+    uintptr_t cursor = (uintptr_t)header + sizeof(mach_header_64);
+    for (uint32_t i = 0; i < header->ncmds; i++) {
+        const load_command *command = (const load_command *)cursor;
+        if (command->cmd == LC_SEGMENT_64 && strcmp(((const segment_command_64 *)command)->segname, SEG_LINKEDIT) == 0) {
+            linkedit = (const segment_command_64 *)command;
+        } else if (command->cmd == LC_SYMTAB) {
+            symtab = (const symtab_command *)command;
+        } else if (command->cmd == LC_DYSYMTAB) {
+            dysymtab = (const dysymtab_command *)command;
+        }
+        cursor += command->cmdsize;
+    }
+    if (!linkedit || !symtab || !dysymtab || dysymtab->nindirectsyms == 0) {
+        return;
+    }
+    const uintptr_t linkeditBase = slide + linkedit->vmaddr - linkedit->fileoff;
+    const nlist_64 *symbols = (const nlist_64 *)(linkeditBase + symtab->symoff);
+    const char *strings = (const char *)(linkeditBase + symtab->stroff);
+    const uint32_t *indirectSymbols = (const uint32_t *)(linkeditBase + dysymtab->indirectsymoff);
+
+    cursor = (uintptr_t)header + sizeof(mach_header_64);
+    for (uint32_t i = 0; i < header->ncmds; i++) {
+        const load_command *command = (const load_command *)cursor;
+        cursor += command->cmdsize;
+        if (command->cmd != LC_SEGMENT_64) {
+            continue;
+        }
+        const segment_command_64 *segment = (const segment_command_64 *)command;
+        if (strcmp(segment->segname, SEG_DATA) != 0 && strcmp(segment->segname, "__DATA_CONST") != 0) {
+            continue;
+        }
+        const section_64 *sections = (const section_64 *)(segment + 1);
+        for (uint32_t j = 0; j < segment->nsects; j++) {
+            const uint32_t type = sections[j].flags & SECTION_TYPE;
+            if (type == S_LAZY_SYMBOL_POINTERS || type == S_NON_LAZY_SYMBOL_POINTERS) {
+                rebindSection(&sections[j], slide, symbols, strings, indirectSymbols);
+            }
+        }
+    }
+}
+
+// MARK: - API
+
+void S1RealtimeWatchdogInstall(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        if (pthread_key_create(&sRealtimeKey, nullptr) != 0) {
+            return;
+        }
+        for (const S1Rebinding &rebinding : sRebindings) {
+            *rebinding.original = dlsym(RTLD_DEFAULT, rebinding.symbol + 1);
+        }
+        hookMallocZones();
+        _dyld_register_func_for_add_image(rebindImage);
+        sIsInstalled.store(true, std::memory_order_release);
+    });
+}
+
+void S1RealtimeWatchdogEnter(void) {
+    if (sIsInstalled.load(std::memory_order_acquire)) {
+        pthread_setspecific(sRealtimeKey, kRealtime);
+    }
+}
+
+void S1RealtimeWatchdogExit(void) {
+    if (sIsInstalled.load(std::memory_order_acquire)) {
+        pthread_setspecific(sRealtimeKey, nullptr);
+    }
+}
+
+NSInteger S1RealtimeWatchdogViolationCount(void) {
+    return std::min(sClaimedViolations.load(std::memory_order_acquire), S1_REALTIME_WATCHDOG_MAX_VIOLATIONS);
+}
+
+NSString *S1RealtimeWatchdogReport(NSInteger firstViolation, NSInteger *nextViolation) {
+    NSMutableString *report = [NSMutableString string];
+    const NSInteger count = S1RealtimeWatchdogViolationCount();
+    NSInteger i = firstViolation;
+    for (; i < count; i++) {
+        const S1RealtimeViolation &violation = sViolations[i];
+        if (!violation.isRecorded.load(std::memory_order_acquire)) {
+            break;
+        }
+        [report appendFormat:@"real-time violation: %s on the render thread (%u times)\n",
+         violation.function, violation.occurrences.load(std::memory_order_relaxed)];
+        char **symbols = backtrace_symbols(violation.frames, violation.frameCount);
+        for (int frame = 0; symbols && frame < violation.frameCount; frame++) {
+            [report appendFormat:@"    %s\n", symbols[frame]];
+        }
+        free(symbols);
+    }
+    if (nextViolation) {
+        *nextViolation = i;
+    }
+    return report;
+}
+
+void S1RealtimeWatchdogReset(void) {
+    for (S1RealtimeViolation &violation : sViolations) {
+        violation.isRecorded.store(false, std::memory_order_relaxed);
+    }
+    sClaimedViolations.store(0, std::memory_order_release);
+}
+
+#else
+
+void S1RealtimeWatchdogInstall(void) {}
+void S1RealtimeWatchdogEnter(void) {}
+void S1RealtimeWatchdogExit(void) {}
+NSInteger S1RealtimeWatchdogViolationCount(void) { return 0; }
+NSString *S1RealtimeWatchdogReport(NSInteger firstViolation, NSInteger *nextViolation) {
+    if (nextViolation) {
+        *nextViolation = firstViolation;
+    }
+    return @"";
+}
+void S1RealtimeWatchdogReset(void) {}
+
+#endif
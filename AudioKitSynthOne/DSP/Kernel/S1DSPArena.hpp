@@ -0,0 +1,108 @@
+//
+//  S1DSPArena.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  One block of memory per kernel out of which its Soundpipe module state and effect buffers are carved, each on
+//  its own cache lines, in the order it is carved.  Nothing is freed piece by piece: reset empties the whole arena
+//  and rewind everything carved after a mark.
+
+#pragma once
+
+#import <cassert>
+#import <cstdlib>
+#import <new>
+#import <type_traits>
+
+#ifdef __cplusplus
+
+class S1DSPArena {
+
+public:
+
+    static constexpr size_t kAlignment = 64;
+
+    static constexpr size_t alignedSize(size_t bytes) {
+        return (bytes + kAlignment - 1) & ~(kAlignment - 1);
+    }
+
+    // bytes taken by one object of each of T
+    template <typename... T>
+    static constexpr size_t footprint() {
+        return (alignedSize(sizeof(T)) + ... + 0);
+    }
+
+    S1DSPArena(const S1DSPArena&) = delete;
+
+    S1DSPArena() = default;
+
+    ~S1DSPArena() {
+        free(mBase);
+    }
+
+    // NOT REALTIME: empty the arena, with room for capacity bytes.  Allocates only when capacity grows.
+    // Returns false, leaving the arena without room, if the allocation fails
+    bool reset(size_t capacity) {
+        if (capacity > mCapacity) {
+            free(mBase);
+            void *base = nullptr;
+            if (posix_memalign(&base, kAlignment, capacity) != 0) {
+                base = nullptr;
+            }
+            mBase = static_cast<char *>(base);
+            mCapacity = mBase ? capacity : 0;
+        }
+        mUsed = 0;
+        return mBase != nullptr;
+    }
+
+    size_t mark() const {
+        return mUsed;
+    }
+
+    // REALTIME: discard everything carved after mark, to be carved again
+    void rewind(size_t mark) {
+        assert(mark <= mUsed);
+        mUsed = mark;
+    }
+
+    // REALTIME: bytes of uninitialized memory, or nullptr if the arena has no room for them
+    void *allocate(size_t bytes) {
+        if (mUsed + alignedSize(bytes) > mCapacity) {
+            return nullptr;
+        }
+        void *memory = mBase + mUsed;
+        mUsed += alignedSize(bytes);
+        return memory;
+    }
+
+    bool contains(const void *memory) const {
+        return memory >= mBase && memory < mBase + mCapacity;
+    }
+
+    // REALTIME: a value-initialized T.  Its destructor is never run
+    template <typename T>
+    T *make() {
+        static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+        void *memory = allocate(sizeof(T));
+        assert(memory != nullptr);
+        return new (memory) T();
+    }
+
+    // REALTIME: in place of sp_*_create for a module whose create only mallocs its struct.
+    // Never pass the module to sp_*_destroy
+    template <typename T>
+    void create(T **module) {
+        *module = make<T>();
+    }
+
+private:
+
+    char *mBase = nullptr;
+    size_t mCapacity = 0;
+    size_t mUsed = 0;
+};
+
+#endif
@@ -55,6 +55,15 @@ struct S1Compressor {
         }
     }
 
+    // attack and release coefficients are computed at the rate of mSp by init; clears the envelope.
+    // sp_compressor_init creates a new Faust instance, so the compressors are created again
+    void updateSampleRate() {
+        mCompressorR.reset(SPCompressorAllocator::allocate());
+        mCompressorL.reset(SPCompressorAllocator::allocate());
+        sp_compressor_init(mSp, mCompressorR.get());
+        sp_compressor_init(mSp, mCompressorL.get());
+    }
+
 private:
 
     void configure(sp_compressor *comp) {
@@ -8,63 +8,92 @@
 
 #import "S1DSPKernel.hpp"
 #import "AEArray.h"
-#import "AEMessageQueue.h"
 #import "S1NoteState.hpp"
 
 void S1DSPKernel::dependentParameterDidChange(DependentParameter param) {
-    AEMessageQueuePerformSelectorOnMainThread(audioUnit->_messageQueue,
-                                              audioUnit,
-                                              @selector(dependentParameterDidChange:),
-                                              AEArgumentStruct(param),
-                                              AEArgumentNone);
+    if (!publishesDependentParameterChanges) {
+        return;
+    }
+
+    // the main thread poll keeps only the latest change of each parameter
+    if (!mDependentParameterChanges.push(param)) {
+        mDroppedDependentParameterChanges.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 //can be called from within the render loop
 void S1DSPKernel::beatCounterDidChange() {
-    S1ArpBeatCounter retVal = {sequencer.getArpBeatCount(), heldNoteNumbersAE.count};
-    AEMessageQueuePerformSelectorOnMainThread(audioUnit->_messageQueue,
-                                              audioUnit,
-                                              @selector(arpBeatCounterDidChange:),
-                                              AEArgumentStruct(retVal),
-                                              AEArgumentNone);
+    mStateChanges.fetch_or(StateChangeBeatCounter, std::memory_order_relaxed);
 }
 
-
 ///can be called from within the render loop
 void S1DSPKernel::playingNotesDidChange() {
-    aePlayingNotes.polyphony = S1_MAX_POLYPHONY;
-    if (parameters[isMono] > 0.f) {
-        aePlayingNotes.playingNotes[0] = { monoNote->rootNoteNumber, monoNote->transpose, monoNote->velocity, monoNote->amp };
-        for(int i = 1; i<S1_MAX_POLYPHONY; i++) {
-            aePlayingNotes.playingNotes[i] = { -1, -1, -1, -1 };
+    mStateChanges.fetch_or(StateChangePlayingNotes, std::memory_order_relaxed);
+}
+
+///can be called from within the render loop
+void S1DSPKernel::heldNotesDidChange() {
+    mStateChanges.fetch_or(StateChangeHeldNotes, std::memory_order_relaxed);
+}
+
+void S1DSPKernel::publishStateSnapshot() {
+    const uint32_t changes = mStateChanges.exchange(0, std::memory_order_relaxed);
+    if (changes == 0) {
+        return;
+    }
+
+    if (changes & StateChangeHeldNotes) {
+        mState.heldNoteBits.fill(0);
+        int count = 0;
+        AEArrayEnumeratePointers(heldNoteNumbersAE, NoteNumber *, note) {
+            const int nn = note->noteNumber;
+            mState.heldNoteBits[nn >> 6] |= uint64_t(1) << (nn & 63);
+            ++count;
         }
-    } else {
-        for(int i=0; i<S1_MAX_POLYPHONY; i++) {
-            const auto& note = (*noteStates)[i];
-            aePlayingNotes.playingNotes[i] = { note.rootNoteNumber, note.transpose, note.velocity, note.amp };
+        mState.heldNotesCount = count;
+        mState.heldNotesVersion++;
+    }
+
+    if (changes & StateChangeBeatCounter) {
+        mState.beatCounter = sequencer.getArpBeatCount();
+        mState.heldNotesCount = heldNoteNumbersAE.count;
+        mState.beatCounterVersion++;
+    }
+
+    if (changes & StateChangePlayingNotes) {
+        PlayingNotes& playingNotes = mState.playingNotes;
+        playingNotes.polyphony = S1_MAX_POLYPHONY;
+        if (parameters[isMono] > 0.f) {
+            playingNotes.playingNotes[0] = { monoNote->rootNoteNumber, monoNote->transpose, monoNote->velocity, monoNote->amp };
+            for(int i = 1; i<S1_MAX_POLYPHONY; i++) {
+                playingNotes.playingNotes[i] = { -1, -1, -1, -1 };
+            }
+        } else {
+            for(int i=0; i<S1_MAX_POLYPHONY; i++) {
+                const auto& note = (*noteStates)[i];
+                playingNotes.playingNotes[i] = { note.rootNoteNumber, note.transpose, note.velocity, note.amp };
+            }
         }
+        mState.playingNotesVersion++;
     }
-    AEMessageQueuePerformSelectorOnMainThread(audioUnit->_messageQueue,
-                                              audioUnit,
-                                              @selector(playingNotesDidChange:),
-                                              AEArgumentStruct(aePlayingNotes),
-                                              AEArgumentNone);
+
+    mState.version++;
+    mStateSnapshots.back() = mState;
+    mStateSnapshots.publish();
 }
 
-///can be called from within the render loop
-void S1DSPKernel::heldNotesDidChange() {
-    for(int i = 0; i<S1_NUM_MIDI_NOTES; i++)
-        aeHeldNotes.heldNotes[i] = false;
-    int count = 0;
-    AEArrayEnumeratePointers(heldNoteNumbersAE, NoteNumber *, note) {
-        const int nn = note->noteNumber;
-        aeHeldNotes.heldNotes[nn] = true;
-        ++count;
+bool S1DSPKernel::readStateSnapshot(S1StateSnapshot &snapshot) {
+    if (!mStateSnapshots.update()) {
+        return false;
     }
-    aeHeldNotes.heldNotesCount = count;
-    AEMessageQueuePerformSelectorOnMainThread(audioUnit->_messageQueue,
-                                              audioUnit,
-                                              @selector(heldNotesDidChange:),
-                                              AEArgumentStruct(aeHeldNotes),
-                                              AEArgumentNone);
+    snapshot = mStateSnapshots.front();
+    return true;
+}
+
+bool S1DSPKernel::popDependentParameterChange(DependentParameter &param) {
+    return mDependentParameterChanges.pop(param);
+}
+
+uint32_t S1DSPKernel::takeDroppedDependentParameterChanges() {
+    return mDroppedDependentParameterChanges.exchange(0, std::memory_order_relaxed);
 }
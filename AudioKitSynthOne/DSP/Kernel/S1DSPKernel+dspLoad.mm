@@ -0,0 +1,40 @@
+//
+//  S1DSPKernel+dspLoad.mm
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+
+#import "S1DSPKernel.hpp"
+#import "S1NoteState.hpp"
+
+void S1DSPKernel::beginRenderCycle() {
+    mLoadMonitor.beginCycle();
+}
+
+void S1DSPKernel::endRenderCycle(AUAudioFrameCount frameCount) {
+    // the voices renderNoteStates runs
+    int activeVoices = 0;
+    if (initializedNoteStates) {
+        if (parameters[isMono] > 0.f) {
+            activeVoices = (monoNote->rootNoteNumber != -1 && monoNote->stage != S1NoteState::stageOff) ? 1 : 0;
+        } else {
+            for (int i = 0; i < polyphony; i++) {
+                const S1NoteState& note = (*noteStates)[i];
+                if (note.rootNoteNumber != -1 && note.stage != S1NoteState::stageOff) {
+                    activeVoices++;
+                }
+            }
+        }
+    }
+    mLoadMonitor.endCycle(frameCount, activeVoices);
+}
+
+bool S1DSPKernel::readDSPLoad(S1DSPLoad &load) {
+    return mLoadMonitor.read(load);
+}
+
+void S1DSPKernel::resetDSPLoad() {
+    mLoadMonitor.reset();
+}
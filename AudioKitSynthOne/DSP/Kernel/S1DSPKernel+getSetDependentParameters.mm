@@ -44,7 +44,7 @@ void S1DSPKernel::setDependentParameter(S1Parameter param, float inputValue01, i
             if (parameters[tempoSyncToArpRate] > 0.f) {
                 // tempo sync
                 AKSynthOneRate rate = _rate.rateFromFrequency01(inputValue01);
-                const float val = _rate.frequency(getSynthParameter(arpRate), rate);
+                const float val = _rate.frequency(syncTempo(), rate);
                 _setSynthParameterHelper(param, val, notify, payload);
             } else {
                 // no tempo sync
@@ -61,7 +61,7 @@ void S1DSPKernel::setDependentParameter(S1Parameter param, float inputValue01, i
                 // tempo sync
                 const float valInvert = 1.f - inputValue01;
                 AKSynthOneRate rate = _rate.rateFromTime01(valInvert);
-                const float val = _rate.time(parameters[arpRate], rate);
+                const float val = _rate.time(syncTempo(), rate);
                 _setSynthParameterHelper(delayTime, val, notify, payload);
             } else {
                 // no tempo sync
@@ -11,21 +11,31 @@
 
 
 float S1DSPKernel::getSynthParameter(S1Parameter param) {
-    S1ParameterInfo& s = s1p[param];
-    if (s.usePortamento)
-        return s.portamentoTarget;
+    // a preset published by loadPreset that the render thread has not applied yet
+    const int presetSlotState = mPresetSlotState.load(std::memory_order_acquire);
+    if (presetSlotState == PresetSlotReady || presetSlotState == PresetSlotReading)
+        return mPendingPreset[param];
+
+    // a change posted by postSynthParameter that the render thread has not applied yet
+    if (mPostedEventCounts[param].load(std::memory_order_acquire) > 0)
+        return mPostedValues[param].load(std::memory_order_relaxed);
+
+    if (const S1PortamentoState *s = portamentoState(param))
+        return s->portamentoTarget;
     else
         return parameters[param];
 }
 
 void S1DSPKernel::_setSynthParameter(S1Parameter param, float inputValue) {
     const float value = clampedValue(param, inputValue);
-    S1ParameterInfo& s = s1p[param];
-    if (s.usePortamento) {
-        s.portamentoTarget = value;
+    if (S1PortamentoState *s = portamentoState(param)) {
+        s->portamentoTarget = value;
     } else {
         parameters[param] = value;
     }
+    if (param >= arpTotalSteps && param <= sequencerNoteOn15) {
+        mSequencerParametersChanged.store(true, std::memory_order_release);
+    }
 }
 
 void S1DSPKernel::setSynthParameter(S1Parameter param, float inputValue) {
@@ -63,7 +73,7 @@ void S1DSPKernel::_rateHelper(S1Parameter parameter, float inputValue, bool noti
         // tempo sync
         if (parameter == lfo1Rate || parameter == lfo2Rate || parameter == autoPanFrequency) {
             const float value = clampedValue(parameter, inputValue);
-            S1RateArgs syncdValue = _rate.nearestFrequency(value, parameters[arpRate], minimum(parameter), maximum(parameter));
+            S1RateArgs syncdValue = _rate.nearestFrequency(value, syncTempo(), minimum(parameter), maximum(parameter));
             _setSynthParameter(parameter, syncdValue.value);
             DependentParameter outputDP = {S1Parameter::S1ParameterCount, 0.f, 0.f, 0};
             switch(parameter) {
@@ -84,7 +94,7 @@ void S1DSPKernel::_rateHelper(S1Parameter parameter, float inputValue, bool noti
             }
         } else if (parameter == delayTime) {
             const float value = clampedValue(parameter, inputValue);
-            S1RateArgs syncdValue = _rate.nearestTime(value, parameters[arpRate], minimum(parameter), maximum(parameter));
+            S1RateArgs syncdValue = _rate.nearestTime(value, syncTempo(), minimum(parameter), maximum(parameter));
             _setSynthParameter(parameter, syncdValue.value);
             _delayTime = {parameter, 1.f - syncdValue.value01, syncdValue.value, payload};
             if (notifyMainThread) {
@@ -124,13 +134,17 @@ void S1DSPKernel::_rateHelper(S1Parameter parameter, float inputValue, bool noti
     }
 }
 
+void S1DSPKernel::updateTempoSyncedRates(bool notifyMainThread, int payload) {
+    _rateHelper(lfo1Rate, getSynthParameter(lfo1Rate), notifyMainThread, payload);
+    _rateHelper(lfo2Rate, getSynthParameter(lfo2Rate), notifyMainThread, payload);
+    _rateHelper(autoPanFrequency, getSynthParameter(autoPanFrequency), notifyMainThread, payload);
+    _rateHelper(delayTime, getSynthParameter(delayTime), notifyMainThread, payload);
+}
+
 void S1DSPKernel::_setSynthParameterHelper(S1Parameter parameter, float inputValue, bool notifyMainThread, int payload) {
     if (parameter == tempoSyncToArpRate || parameter == arpRate) {
         _setSynthParameter(parameter, inputValue);
-        _rateHelper(lfo1Rate, getSynthParameter(lfo1Rate), notifyMainThread, payload);
-        _rateHelper(lfo2Rate, getSynthParameter(lfo2Rate), notifyMainThread, payload);
-        _rateHelper(autoPanFrequency, getSynthParameter(autoPanFrequency), notifyMainThread, payload);
-        _rateHelper(delayTime, getSynthParameter(delayTime), notifyMainThread, payload);
+        updateTempoSyncedRates(notifyMainThread, payload);
     } else if (parameter == lfo1Rate ||
                parameter == lfo2Rate ||
                parameter == autoPanFrequency ||
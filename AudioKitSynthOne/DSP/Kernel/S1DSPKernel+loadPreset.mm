@@ -0,0 +1,109 @@
+//
+//  S1DSPKernel+loadPreset.mm
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+
+#import <thread>
+#import "S1DSPKernel.hpp"
+
+// MAIN THREAD: resolve a complete preset and hand it to the render thread in one swap.
+// Same clamping and dependent rate resolution as setSynthParameter, without the per-parameter notifications.
+void S1DSPKernel::loadPreset(const DSPParameters &preset) {
+    DSPParameters resolved;
+    for (int i = 0; i < S1Parameter::S1ParameterCount; i++) {
+        resolved[i] = clampedValue((S1Parameter)i, preset[i]);
+    }
+
+    // tuning table is based on an integer frequency at A4
+    resolved[frequencyA4] = truncf(resolved[frequencyA4]);
+
+    // dependent params: lfo1Rate, lfo2Rate, autoPanFrequency, delayTime are resolved against the host tempo,
+    // else the preset's arpRate.  The render thread resolves them again when it applies the preset
+    const bool tempoSync = resolved[tempoSyncToArpRate] > 0.f;
+    const float hostTempo = mHostTempo.load(std::memory_order_relaxed);
+    const float presetArpRate = hostTempo > 0.f ? hostTempo : resolved[arpRate];
+    auto resolveRate = [&](S1Parameter parameter) -> DependentParameter {
+        const float value = resolved[parameter];
+        const float min = minimum(parameter);
+        const float max = maximum(parameter);
+        if (tempoSync) {
+            if (parameter == delayTime) {
+                const S1RateArgs syncdValue = _rate.nearestTime(value, presetArpRate, min, max);
+                resolved[parameter] = syncdValue.value;
+                return {parameter, 1.f - syncdValue.value01, syncdValue.value, 0};
+            }
+            const S1RateArgs syncdValue = _rate.nearestFrequency(value, presetArpRate, min, max);
+            resolved[parameter] = syncdValue.value;
+            return {parameter, syncdValue.value01, syncdValue.value, 0};
+        }
+        const float val01 = clamp((value - min) / (max - min), 0.f, 1.f);
+        return {parameter, val01, value, 0};
+    };
+    const DependentParameter lfo1RateDP = resolveRate(lfo1Rate);
+    const DependentParameter lfo2RateDP = resolveRate(lfo2Rate);
+    const DependentParameter autoPanRateDP = resolveRate(autoPanFrequency);
+    const DependentParameter delayTimeDP = resolveRate(delayTime);
+
+    // arpSeqTempoMultiplier
+    const S1RateArgs syncdFactor = _rate.nearestFactor(resolved[arpSeqTempoMultiplier]);
+    resolved[arpSeqTempoMultiplier] = syncdFactor.value;
+    const DependentParameter arpSeqTempoMultiplierDP = {arpSeqTempoMultiplier, 1.f - syncdFactor.value01, syncdFactor.value, 0};
+
+    // take the slot: either free, or holding a preset the render thread has not picked up yet
+    int expected = PresetSlotFree;
+    while (!mPresetSlotState.compare_exchange_weak(expected, PresetSlotWriting, std::memory_order_acquire)) {
+        if (expected != PresetSlotReady) {
+            // render thread is applying the previous preset
+            expected = PresetSlotFree;
+            std::this_thread::yield();
+        }
+    }
+    mPendingPreset = resolved;
+    mPendingPresetSerial = mParameterEventSerial.load(std::memory_order_relaxed);
+    mPresetSlotState.store(PresetSlotReady, std::memory_order_release);
+
+    updatePortamento(resolved[portamentoHalfTime]);
+
+    _lfo1Rate = lfo1RateDP;
+    _lfo2Rate = lfo2RateDP;
+    _autoPanRate = autoPanRateDP;
+    _delayTime = delayTimeDP;
+    _arpSeqTempoMultiplier = arpSeqTempoMultiplierDP;
+
+    // one notification per dependent parameter instead of one per setSynthParameter
+    for (DependentParameter dp : {lfo1RateDP, lfo2RateDP, autoPanRateDP, delayTimeDP}) {
+        if (!tempoSync) {
+            dp.normalizedValue = taper01Inverse(dp.normalizedValue, S1_DEPENDENT_PARAM_TAPER);
+        }
+        dependentParameterDidChange(dp);
+    }
+    dependentParameterDidChange(arpSeqTempoMultiplierDP);
+}
+
+// RENDER THREAD: called by process at a buffer boundary.  Never waits on the main thread.
+// Parameter changes posted before the preset do not override it.
+bool S1DSPKernel::applyPendingPreset() {
+    int expected = PresetSlotReady;
+    if (!mPresetSlotState.compare_exchange_strong(expected, PresetSlotReading, std::memory_order_acquire)) {
+        return false;
+    }
+    discardParameterEvents(mPendingPresetSerial);
+    for (int i = 0; i < S1Parameter::S1ParameterCount; i++) {
+        if (S1PortamentoState *s = portamentoState((S1Parameter)i)) {
+            s->portamentoTarget = mPendingPreset[i];
+        } else {
+            parameters[i] = mPendingPreset[i];
+        }
+    }
+    mPresetSlotState.store(PresetSlotFree, std::memory_order_release);
+    mSequencerParametersChanged.store(true, std::memory_order_relaxed);
+
+    // the host tempo may have changed since loadPreset resolved the tempo-synced rates
+    if (mHostTempo.load(std::memory_order_relaxed) > 0.f) {
+        updateTempoSyncedRates(true, 0);
+    }
+    return true;
+}
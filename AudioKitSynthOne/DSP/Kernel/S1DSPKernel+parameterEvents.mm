@@ -0,0 +1,144 @@
+//
+//  S1DSPKernel+parameterEvents.mm
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+
+#import "S1DSPKernel.hpp"
+
+void S1DSPKernel::postSynthParameter(S1Parameter param, float value, AUEventSampleTime sampleTime, AUAudioFrameCount rampDuration) {
+    mPostedValues[param].store(clampedValue(param, value), std::memory_order_relaxed);
+    mPostedEventCounts[param].fetch_add(1, std::memory_order_release);
+    const uint32_t serial = mParameterEventSerial.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (!mParameterEventQueue.push({param, value, sampleTime, rampDuration, serial})) {
+        // the queue is full: coalesce into mPostedValues; a change already coalesced counts for this one
+        if (mCoalescedEventSerials[param].exchange(serial, std::memory_order_release) != 0) {
+            mPostedEventCounts[param].fetch_sub(1, std::memory_order_relaxed);
+        }
+        mHasCoalescedEvents.store(true, std::memory_order_release);
+    }
+}
+
+// RENDER THREAD: called by process at the start of each buffer.
+// Applies the events that are due and schedules future events in sampleTime order.
+// Events posted before the last applied preset are dropped.
+void S1DSPKernel::drainParameterEvents(AUEventSampleTime sampleTime) {
+    S1ParameterEvent event;
+    while (mParameterEventQueue.pop(event)) {
+        if ((int32_t)(event.serial - mStaleEventSerial) <= 0) {
+            mPostedEventCounts[event.parameter].fetch_sub(1, std::memory_order_release);
+            continue;
+        }
+        if (event.sampleTime <= sampleTime || mScheduledEventCount == S1_MAX_SCHEDULED_PARAMETER_EVENTS) {
+            applyParameterEvent(event);
+            continue;
+        }
+        int i = mScheduledEventCount++;
+        while (i > 0 && mScheduledEvents[i - 1].sampleTime > event.sampleTime) {
+            mScheduledEvents[i] = mScheduledEvents[i - 1];
+            --i;
+        }
+        mScheduledEvents[i] = event;
+    }
+    if (mHasCoalescedEvents.exchange(false, std::memory_order_acquire)) {
+        drainCoalescedParameterEvents();
+    }
+}
+
+// RENDER THREAD: the latest posted value of each parameter whose change did not fit the queue, without a ramp.
+// Applied after the queue, whose events for the parameter are no newer than its posted value
+void S1DSPKernel::drainCoalescedParameterEvents() {
+    for (int i = 0; i < S1Parameter::S1ParameterCount; i++) {
+        const uint32_t serial = mCoalescedEventSerials[i].exchange(0, std::memory_order_acquire);
+        if (serial == 0) {
+            continue;
+        }
+        const S1Parameter param = (S1Parameter)i;
+        if ((int32_t)(serial - mStaleEventSerial) > 0) {
+            startParameterRamp(param, mPostedValues[i].load(std::memory_order_relaxed), 0);
+        }
+        mPostedEventCounts[i].fetch_sub(1, std::memory_order_release);
+    }
+}
+
+// RENDER THREAD: called by applyPendingPreset.  Ramps in progress all started before the preset
+void S1DSPKernel::discardParameterEvents(uint32_t presetSerial) {
+    mStaleEventSerial = presetSerial;
+    int kept = 0;
+    for (int i = 0; i < mScheduledEventCount; i++) {
+        const S1ParameterEvent& event = mScheduledEvents[i];
+        if ((int32_t)(event.serial - presetSerial) <= 0) {
+            mPostedEventCounts[event.parameter].fetch_sub(1, std::memory_order_release);
+        } else {
+            mScheduledEvents[kept++] = event;
+        }
+    }
+    mScheduledEventCount = kept;
+    mRampCount = 0;
+}
+
+// RENDER THREAD: called by process for each frame while events are scheduled or ramps are active
+void S1DSPKernel::processParameterEvents(AUEventSampleTime sampleTime) {
+
+    // scheduled events that are due
+    int due = 0;
+    while (due < mScheduledEventCount && mScheduledEvents[due].sampleTime <= sampleTime) {
+        applyParameterEvent(mScheduledEvents[due]);
+        ++due;
+    }
+    if (due > 0) {
+        std::copy(mScheduledEvents.begin() + due, mScheduledEvents.begin() + mScheduledEventCount, mScheduledEvents.begin());
+        mScheduledEventCount -= due;
+    }
+
+    // ramps: only notify the main thread of dependent parameters when a ramp ends
+    const int rampCount = mRampCount;
+    bool rampEnded = false;
+    for (int i = 0; i < mRampCount; i++) {
+        ParameterRamp& ramp = mRamps[i];
+        if (--ramp.framesRemaining == 0) {
+            _setSynthParameterHelper(ramp.parameter, ramp.target, true, 0);
+            mRamps[i--] = mRamps[--mRampCount];
+            rampEnded = true;
+        } else {
+            ramp.value += ramp.increment;
+            _setSynthParameterHelper(ramp.parameter, ramp.value, false, 0);
+        }
+    }
+
+    // pitch ratios, LFO routing, voice renderers and envelopes: sample-accurate for events and the end of a ramp,
+    // once per LFO control block while a ramp moves
+    if (due > 0 || rampEnded || (rampCount > 0 && sampleTime % S1_LFO_BLOCK_SIZE == 0)) {
+        updateParameterDependents();
+    }
+}
+
+void S1DSPKernel::applyParameterEvent(const S1ParameterEvent &event) {
+    startParameterRamp(event.parameter, event.value, event.rampDuration);
+    mPostedEventCounts[event.parameter].fetch_sub(1, std::memory_order_release);
+}
+
+// a duration of 0 jumps to value and cancels any ramp of param
+void S1DSPKernel::startParameterRamp(S1Parameter param, float value, AUAudioFrameCount duration) {
+    int index = 0;
+    while (index < mRampCount && mRamps[index].parameter != param) {
+        ++index;
+    }
+    if (duration == 0 || (index == mRampCount && mRampCount == S1_MAX_PARAMETER_RAMPS)) {
+        if (index < mRampCount) {
+            mRamps[index] = mRamps[--mRampCount];
+        }
+        _setSynthParameterHelper(param, value, true, 0);
+        return;
+    }
+    if (index == mRampCount) {
+        ++mRampCount;
+    }
+    // current render-thread value; getSynthParameter would return the pending posted value
+    const S1PortamentoState *s = portamentoState(param);
+    const float start = s ? s->portamentoTarget : parameters[param];
+    const float target = clampedValue(param, value);
+    mRamps[index] = {param, start, (target - start) / (float)duration, target, duration};
+}
@@ -10,52 +10,53 @@
 
 ///parameter min
 float S1DSPKernel::minimum(S1Parameter i) {
-    return s1p[i].minimum;
+    return S1ParameterTable::info(i).minimum;
 }
 
 ///parameter max
 float S1DSPKernel::maximum(S1Parameter i) {
-    return s1p[i].maximum;
+    return S1ParameterTable::info(i).maximum;
 }
 
 ///parameter defaults
 float S1DSPKernel::defaultValue(S1Parameter i) {
-    return clampedValue(i, s1p[i].defaultValue);
+    return clampedValue(i, S1ParameterTable::info(i).defaultValue);
 }
 
 AudioUnitParameterUnit S1DSPKernel::parameterUnit(S1Parameter i) {
-    return s1p[i].unit;
+    return S1ParameterTable::info(i).unit;
 }
 
 ///return clamped value
 float S1DSPKernel::clampedValue(S1Parameter i, float inputValue) {
-    const float minimum = s1p[i].minimum;
-    const float maximum = s1p[i].maximum;
+    const float minimum = S1ParameterTable::info(i).minimum;
+    const float maximum = S1ParameterTable::info(i).maximum;
     const float clampedValue = std::min(std::max(inputValue, minimum), maximum);
     return clampedValue;
 }
 
 ///parameter friendly name as c string
 const char* S1DSPKernel::cString(S1Parameter i) {
-    return s1p[i].friendlyName.c_str();
+    return S1ParameterTable::info(i).friendlyName;
 }
 
 ///parameter friendly name
 std::string S1DSPKernel::friendlyName(S1Parameter i) {
-    return s1p[i].friendlyName;
+    return S1ParameterTable::info(i).friendlyName;
 }
 
 ///parameter presetKey
 std::string S1DSPKernel::presetKey(S1Parameter i) {
-    return s1p[i].presetKey;
+    return S1ParameterTable::info(i).presetKey;
 }
 
 void S1DSPKernel::setParameters(float params[]) {
-    for (int i = 0; i < S1Parameter::S1ParameterCount; i++) {
-        setSynthParameter((S1Parameter)i, params[i]);
-    }
+    DSPParameters preset;
+    std::copy(params, params + S1Parameter::S1ParameterCount, preset.begin());
+    loadPreset(preset);
 }
 
+// RENDER THREAD: AURenderEventParameter from processWithEvents, already sample-accurate
 void S1DSPKernel::setParameter(AUParameterAddress address, AUValue value) {
     const int i = (S1Parameter)address;
     setSynthParameter((S1Parameter)i, value);
@@ -66,21 +67,27 @@ AUValue S1DSPKernel::getParameter(AUParameterAddress address) {
     return parameters[i];
 }
 
-void S1DSPKernel::startRamp(AUParameterAddress address, AUValue value, AUAudioFrameCount duration) {}
+// RENDER THREAD: AURenderEventParameterRamp from processWithEvents
+void S1DSPKernel::startRamp(AUParameterAddress address, AUValue value, AUAudioFrameCount duration) {
+    startParameterRamp((S1Parameter)address, value, duration);
+}
 
 void S1DSPKernel::updatePortamento(float halfTime) {
     const float ht = clampedValue(portamentoHalfTime, halfTime);
-    for(int i = 0; i< S1Parameter::S1ParameterCount; i++) {
-        if (s1p[i].usePortamento) {
-            s1p[i].portamento->htime = ht;
-        }
+    for (S1PortamentoState& s : portamentoStates) {
+        s.portamento->htime = ht;
     }
 }
 
-//TODO:set s1 param arpRate
 void S1DSPKernel::handleTempoSetting(float currentTempo) {
-    if (currentTempo != tempo) {
-        tempo = currentTempo;
-        // TODO: reset secPerBeat here?
+    const float hostTempo = currentTempo > 0.f ? currentTempo : 0.f;
+    if (hostTempo != mHostTempo.load(std::memory_order_relaxed)) {
+        mHostTempo.store(hostTempo, std::memory_order_relaxed);
+        updateTempoSyncedRates(true, 0);
     }
 }
+
+float S1DSPKernel::syncTempo() const {
+    const float hostTempo = mHostTempo.load(std::memory_order_relaxed);
+    return hostTempo > 0.f ? hostTempo : parameters[arpRate];
+}
@@ -11,148 +11,205 @@
 #import "S1DSPKernel.hpp"
 #import "AEArray.h"
 #import "S1NoteState.hpp"
+#import "S1FastMath.hpp"
 
-void S1DSPKernel::process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) {
-    initializeNoteStates();
-
-    // PREPARE FOR RENDER LOOP...updates here happen at 44100/frameCount Hz
-    float* outL = (float*)outBufferListPtr->mBuffers[0].mData + bufferOffset;
-    float* outR = (float*)outBufferListPtr->mBuffers[1].mData + bufferOffset;
-
-    // currently UI is visible in DEV panel only so can't be portamento
+template <bool IsMono>
+inline void S1DSPKernel::renderVoices(int frameIndex, int lfoFrameIndex, float *outL, float *outR) {
+    if (IsMono) {
+        if (monoNote->rootNoteNumber != -1 && monoNote->stage != S1NoteState::stageOff)
+            (monoNote->*mVoiceRenderers[1])(frameIndex, lfoFrameIndex, outL, outR);
+    } else {
+        for(int i=0; i<polyphony; i++) {
+            S1NoteState& note = (*noteStates)[i];
+            if (note.rootNoteNumber != -1 && note.stage != S1NoteState::stageOff)
+                (note.*mVoiceRenderers[0])(frameIndex, lfoFrameIndex, outL, outR);
+        }
+    }
+}
 
+template <bool IsMono, bool IsCrossfading>
+inline void S1DSPKernel::renderNoteStates(int frameIndex, int lfoFrameIndex, float *outL, float *outR) {
+    renderVoices<IsMono>(frameIndex, lfoFrameIndex, outL, outR);
+    if (IsCrossfading) {
+        float fadeOutL = 0.f;
+        float fadeOutR = 0.f;
+        renderVoices<!IsMono>(0, lfoFrameIndex, &fadeOutL, &fadeOutR);
+        outL[frameIndex] += mModeCrossfadeGain * fadeOutL;
+        outR[frameIndex] += mModeCrossfadeGain * fadeOutR;
+    }
+}
 
-    /// transition playing notes from release to off
-    if (parameters[isMono] > 0.f) {
-        if (monoNote->stage == S1NoteState::stageRelease && monoNote->amp < S1_RELEASE_AMPLITUDE_THRESHOLD) {
-            monoNote->clear();
-        }
+template <bool IsMono>
+void S1DSPKernel::clearNoteStates() {
+    if (IsMono) {
+        monoNote->clear();
     } else {
         for(int i=0; i<polyphony; i++) {
-            auto& note = (*noteStates)[i];
-            if (note.stage == S1NoteState::stageRelease && note.amp < S1_RELEASE_AMPLITUDE_THRESHOLD) {
-                note.clear();
-            }
+            (*noteStates)[i].clear();
         }
     }
+}
 
-    /// throttle main thread notification to < 30hz
-    processSampleCounter += frameCount;
-    if (processSampleCounter > 2048.0) {
-        playingNotesDidChange();
-        processSampleCounter = 0;
+void S1DSPKernel::beginModeCrossfade(bool isMonoMode) {
+
+    // a switch back during a crossfade cuts the voices still fading
+    if (mModeCrossfadeFramesRemaining > 0) {
+        if (isMonoMode) {
+            clearNoteStates<true>();
+        } else {
+            clearNoteStates<false>();
+        }
     }
+    mModeCrossfadeFramesRemaining = std::max(1, (int)(S1_MODE_CROSSFADE_SECONDS * sampleRate()));
+    mModeCrossfadeStep = 1.f / mModeCrossfadeFramesRemaining;
+    mModeCrossfadeGain = 1.f;
+    resetted = true;
+    sequencer.reset(true);
+}
 
+// pitchbend and semitone offsets are not portamento parameters: they only change with parameter events and ramps
+void S1DSPKernel::updatePitchRatios() {
+    const std::array<float, 6> inputs {{
+        parameters[morph1SemitoneOffset], parameters[morph2SemitoneOffset], parameters[subOctaveDown],
+        parameters[pitchbend], parameters[pitchbendMinSemitones], parameters[pitchbendMaxSemitones]
+    }};
+    if (inputs == pitchRatioInputs) {
+        return;
+    }
+    pitchRatioInputs = inputs;
+
+    pitchRatios.osc1 = S1FastMath::nnToHz((int)parameters[morph1SemitoneOffset]);
+    pitchRatios.osc2 = S1FastMath::nnToHz((int)parameters[morph2SemitoneOffset]);
+    pitchRatios.sub = 1.f / (2.f * (1.f + parameters[subOctaveDown]));
+
+    const float pbmin = parameters[pitchbendMinSemitones];
+    const float pbmax = parameters[pitchbendMaxSemitones];
+    const float pbVal = parameters[pitchbend];
+    float pitchbendCoefficient = 1.f;
+    if (pbmin < 0.f && pbVal < 8192.f) {
+        const float pbminst = pbmin * ((8191.f - pbVal) / 8191.f);
+        pitchbendCoefficient = S1FastMath::nnToHz(pbminst);
+    } else if (pbmax > 0.f && pbVal >= 8192.f) {
+        const float pbmaxst = pbmax * (-(8192.f - pbVal) / 8192.f);
+        pitchbendCoefficient = S1FastMath::nnToHz(pbmaxst);
+    }
+    pitchRatios.pitchbend = pitchbendCoefficient;
+
+    pitchRatios.version++;
+}
 
+// A generator runs while its volume is heading anywhere but 0, and until its smoothed volume has faded out, so neither
+// turning it on nor off cuts its output.  The smoothed volume alone would keep a faded generator running for as long
+// as the portamento takes to reach exactly 0
+int S1DSPKernel::audibleGenerators() {
+    auto isAudible = [this](S1Parameter volume) {
+        const S1PortamentoState *s = portamentoState(volume);
+        const float target = s ? s->portamentoTarget : parameters[volume];
+        return target != 0.f || fabsf(parameters[volume]) > S1_SILENT_GENERATOR_VOLUME;
+    };
+    int generators = 0;
+    if (isAudible(subVolume)) {
+        generators |= S1NoteState::subGenerator;
+        if (parameters[subIsSquare] != 0.f) {
+            generators |= S1NoteState::squareSubGenerator;
+        }
+    }
+    if (isAudible(fmVolume)) {
+        generators |= S1NoteState::fmGenerator;
+    }
+    if (isAudible(noiseVolume)) {
+        generators |= S1NoteState::noiseGenerator;
+    }
+    return generators;
+}
+
+void S1DSPKernel::updateParameterDependents() {
+    updatePitchRatios();
+    modulationMatrix.update(parameters);
+
+    // voice specializations, for the current mode and a mode fading out
+    const int generators = audibleGenerators();
+    const int type = std::min(std::max((int)parameters[filterType], 0), 2);
+    mVoiceRenderers[0] = S1NoteState::renderer(false, generators, type);
+    mVoiceRenderers[1] = S1NoteState::renderer(true, generators, type);
+
+    // envelope poles at the voice rate; voices turn themselves off the sample their release ends
+    ampEnvelopeShape.update(parameters[attackDuration], parameters[decayDuration], parameters[sustainLevel],
+                            parameters[releaseDuration], voiceSp->sr);
+    filterEnvelopeShape.update(parameters[filterAttackDuration], parameters[filterDecayDuration], parameters[filterSustainLevel],
+                               parameters[filterReleaseDuration], voiceSp->sr);
+}
+
+template <bool IsMono, bool IsCrossfading>
+void S1DSPKernel::renderFrames(AUAudioFrameCount frameBegin, AUAudioFrameCount frameEnd, AUAudioFrameCount frameCount,
+                               AUEventSampleTime bufferSampleTime, float *outL, float *outR,
+                               S1DSPLoadMonitor::Ticks &stageStart) {
     ///MARK: RENDER LOOP: Render one audio frame at sample rate, i.e. 44100 HZ
-    for (AUAudioFrameCount frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+    for (AUAudioFrameCount frameIndex = frameBegin; frameIndex < frameEnd; ++frameIndex) {
 
         // CLEAR BUFFER
         outL[frameIndex] = outR[frameIndex] = 0.f;
 
+        // sample-accurate parameter events and ramps
+        if (mScheduledEventCount > 0 || mRampCount > 0) {
+            processParameterEvents(bufferSampleTime + frameIndex);
+        }
+
         ///MARK:MONO CHAIN
         // MONO chain uses outL, ignores outR.  STEREO starts at AutoPan
 
         //MARK: PORTAMENTO
-        for(int i = 0; i< S1Parameter::S1ParameterCount; i++) {
-            if (s1p[i].usePortamento) {
-                sp_port_compute(sp, s1p[i].portamento, &s1p[i].portamentoTarget, &parameters[i]);
-            }
+        for(int i = 0; i < S1PortamentoParameters::kCount; i++) {
+            S1PortamentoState& s = portamentoStates[i];
+            sp_port_compute(sp, s.portamento, &s.portamentoTarget, &parameters[S1Portamento.parameters[i]]);
         }
+        // only the mono note glides, but the port runs in both modes so a poly->mono switch glides from a current value
         monoFrequencyPort->htime = parameters[glide]; // mono freq port halftime set by UI
         sp_port_compute(sp, monoFrequencyPort, &monoFrequency, &monoFrequencySmooth);
 
-        // Clear all notes when toggling Mono <==> Poly
-        if (parameters[isMono] != previousProcessMonoPolyStatus ) {
-            previousProcessMonoPolyStatus = parameters[isMono];
-            reset(); // clears all mono and poly notes
-            sequencer.reset(true);
-        }
-
         //MARK: LFO
-        ///LFO1 on [-1, 1]
-        float lfo1;
-        lfo1Phasor->freq = parameters[lfo1Rate];
-        sp_phasor_compute(sp, lfo1Phasor, nil, &lfo1); // sp_phasor_compute [0,1]
-        if (parameters[lfo1Index] == 0) { // Sine
-            lfo1 = sin(lfo1 * M_PI * 2.f);
-        } else if (parameters[lfo1Index] == 1) { // Square
-            if (lfo1 > 0.5f) {
-                lfo1 = 1.f;
-            } else {
-                lfo1 = -1.f;
-            }
-        } else if (parameters[lfo1Index] == 2) { // Saw
-            lfo1 = (lfo1 - 0.5f) * 2.f;
-        } else if (parameters[lfo1Index] == 3) { // Reversed Saw
-            lfo1 = (0.5f - lfo1) * 2.f;
+        // LFOs render a control block at a time; voices and effects read frame lfoFrameIndex of it
+        const int lfoFrameIndex = frameIndex % S1_LFO_BLOCK_SIZE;
+        if (lfoFrameIndex == 0) {
+            mLFOBank.render(std::min<int>(frameCount - frameIndex, S1_LFO_BLOCK_SIZE), parameters);
         }
 
-        // smooth lfo1 (for discontinous square, saw, reversed saw)
-        sp_port_compute(sp, lfo1Port, &lfo1, &lfo1Smooth);
-        lfo1_0_1 = 0.5f * (1.f + lfo1Smooth) * parameters[lfo1Amplitude];
-        lfo1_1_0 = 1.f - (0.5f * (1.f + -lfo1Smooth) * parameters[lfo1Amplitude]);
-
-        //LFO2 on [-1, 1]
-        float lfo2;
-        lfo2Phasor->freq = parameters[lfo2Rate];
-        sp_phasor_compute(sp, lfo2Phasor, nil, &lfo2);  // sp_phasor_compute [0,1]
-        if (parameters[lfo2Index] == 0) { // Sine
-            lfo2 = sin(lfo2 * M_PI * 2.0);
-        } else if (parameters[lfo2Index] == 1) { // Square
-            if (lfo2 > 0.5f) {
-                lfo2 = 1.f;
-            } else {
-                lfo2 = -1.f;
-            }
-        } else if (parameters[lfo2Index] == 2) { // Saw
-            lfo2 = (lfo2 - 0.5f) * 2.f;
-        } else if (parameters[lfo2Index] == 3) { // Reversed Saw
-            lfo2 = (0.5f - lfo2) * 2.f;
-        }
-
-        // smooth lfo1 (for discontinous square, saw, reversed saw)
-        sp_port_compute(sp, lfo2Port, &lfo2, &lfo2Smooth);
-        lfo2_0_1 = 0.5f * (1.f + lfo2Smooth) * parameters[lfo2Amplitude];
-        lfo2_1_0 = 1.f - (0.5f * (1.f + -lfo2Smooth) * parameters[lfo2Amplitude]);
-
-        // combinations of lfo1 and lfo2
-        lfo3_0_1 = 0.5f * (lfo1_0_1 + lfo2_0_1);
-        lfo3_1_0 = 0.5f * (lfo1_1_0 + lfo2_1_0);
+        stageStart = mLoadMonitor.mark(S1DSPLoadMonitor::modulation, stageStart);
 
         /// MARK: ARPEGGIATOR + SEQUENCER BEGIN
-        sequencer.process(parameters, heldNoteNumbersAE);
+        sequencer.process(parameters, heldNoteNumbersAE, frameIndex, *this);
         /// MARK: ARPEGGIATOR + SEQUENCER END
+        stageStart = mLoadMonitor.mark(S1DSPLoadMonitor::sequencer, stageStart);
 
         /// MONO
         /// MARK: MONO CHAIN (EFX):
 
         // RENDER NoteState into (outL, outR)
-        if (parameters[isMono] > 0.f) {
-            if (monoNote->rootNoteNumber != -1 && monoNote->stage != S1NoteState::stageOff)
-                monoNote->run(frameIndex, outL, outR);
+        if (oversamplingFactor == 1) {
+            renderNoteStates<IsMono, IsCrossfading>(frameIndex, lfoFrameIndex, outL, outR);
         } else {
-            for(int i=0; i<polyphony; i++) {
-                S1NoteState& note = (*noteStates)[i];
-                if (note.rootNoteNumber != -1 && note.stage != S1NoteState::stageOff)
-                    note.run(frameIndex, outL, outR);
+            // render oversamplingFactor voice frames then decimate to one host frame
+            float voiceOutL[S1_MAX_OVERSAMPLING] = {0.f};
+            float voiceOutR[S1_MAX_OVERSAMPLING] = {0.f};
+            for (int i = 0; i < oversamplingFactor; i++) {
+                renderNoteStates<IsMono, IsCrossfading>(i, lfoFrameIndex, voiceOutL, voiceOutR);
             }
+            outL[frameIndex] = mOversampler.decimate(voiceOutL, oversamplingFactor);
+        }
+        if (IsCrossfading) {
+            mModeCrossfadeGain -= mModeCrossfadeStep;
         }
+        stageStart = mLoadMonitor.mark(S1DSPLoadMonitor::voices, stageStart);
 
         // MONO: NoteState render output "synthOut" is mono
         float synthOut = outL[frameIndex];
 
         // BITCRUSH LFO
         float bitcrushSrate = parameters[bitCrushSampleRate];
-        bitcrushSrate = log2(bitcrushSrate);
+        bitcrushSrate = S1FastMath::log2(bitcrushSrate);
         const float magicNumber = 4.f;
-        if (parameters[bitcrushLFO] == 1.f)
-            bitcrushSrate += magicNumber * lfo1_0_1;
-        else if (parameters[bitcrushLFO] == 2.f)
-            bitcrushSrate += magicNumber * lfo2_0_1;
-        else if (parameters[bitcrushLFO] == 3.f)
-            bitcrushSrate += magicNumber * lfo3_0_1;
-        bitcrushSrate = exp2(bitcrushSrate);
+        bitcrushSrate += magicNumber * modulationMatrix.value(S1ModulationDestination::Bitcrush, lfoFrameIndex);
+        bitcrushSrate = S1FastMath::exp2(bitcrushSrate);
         bitcrushSrate = clampedValue(bitCrushSampleRate, bitcrushSrate); // clamp
 
         ///BITCRUSH
@@ -170,12 +227,7 @@ void S1DSPKernel::process(AUAudioFrameCount frameCount, AUAudioFrameCount buffer
         bitcrushSampleIndex += 1.f;
 
         ///TREMOLO
-        if (parameters[tremoloLFO] == 1.f)
-            bitCrushOut *= lfo1_1_0;
-        else if (parameters[tremoloLFO] == 2.f)
-            bitCrushOut *= lfo2_1_0;
-        else if (parameters[tremoloLFO] == 3.f)
-            bitCrushOut *= lfo3_1_0;
+        bitCrushOut *= modulationMatrix.value(S1ModulationDestination::Tremolo, lfoFrameIndex);
 
         ///MARK: STEREO CHAIN (EFX)
 
@@ -206,10 +258,10 @@ void S1DSPKernel::process(AUAudioFrameCount frameCount, AUAudioFrameCount buffer
         float delayInputLowPassOutL = phaserOutL;
         float delayInputLowPassOutR = phaserOutR;
         if(parameters[filterType] == 0.f) {
-            const float pmin2 = log2(1024.f);
-            const float pmax2 = log2(maximum(cutoff));
+            const float pmin2 = 10.f; // log2(1024)
+            const float pmax2 = S1FastMath::log2(maximum(cutoff));
             const float pval1 = parameters[cutoff];
-            float pval2 = log2(pval1);
+            float pval2 = S1FastMath::log2(pval1);
             if (pval2 < pmin2) pval2 = pmin2;
             if (pval2 > pmax2) pval2 = pmax2;
             const float pnorm2 = (pval2 - pmin2)/(pmax2 - pmin2);
@@ -281,12 +333,7 @@ void S1DSPKernel::process(AUAudioFrameCount frameCount, AUAudioFrameCount buffer
         float reverbCrossfadeOutL = 0.f;
         float reverbCrossfadeOutR = 0.f;
         float reverbMixFactor = parameters[reverbMix] * parameters[reverbOn];
-        if (parameters[reverbMixLFO] == 1.f)
-            reverbMixFactor *= lfo1_1_0;
-        else if (parameters[reverbMixLFO] == 2.f)
-            reverbMixFactor *= lfo2_1_0;
-        else if (parameters[reverbMixLFO] == 3.f)
-            reverbMixFactor *= lfo3_1_0;
+        reverbMixFactor *= modulationMatrix.value(S1ModulationDestination::ReverbMix, lfoFrameIndex);
         revCrossfadeL->pos = reverbMixFactor;
         revCrossfadeR->pos = reverbMixFactor;
         sp_crossfade_compute(sp, revCrossfadeL, &mixedDelayL, &wetReverbLimiterL, &reverbCrossfadeOutL);
@@ -310,5 +357,82 @@ void S1DSPKernel::process(AUAudioFrameCount frameCount, AUAudioFrameCount buffer
         // MASTER
         outL[frameIndex] = compressorOutL;
         outR[frameIndex] = widenOutR;
+        stageStart = mLoadMonitor.mark(S1DSPLoadMonitor::effects, stageStart);
+    }
+}
+
+void S1DSPKernel::process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) {
+    // each stage adds the time since the previous mark to the load of this render cycle, if its stages are timed
+    S1DSPLoadMonitor::Ticks stageStart = mLoadMonitor.stageStart();
+
+    initializeNoteStates();
+
+    // a preset discards the changes posted before it, so only events posted after it are applied on top
+    applyPendingPreset();
+    const AUEventSampleTime bufferSampleTime = renderSampleTime + bufferOffset;
+    drainParameterEvents(bufferSampleTime);
+
+    // voice oversampling quality and mono/poly only change between buffers
+    const int factor = S1Oversampler::factorForMode((S1OversamplingMode)(int)parameters[oversampling]);
+    if (factor != oversamplingFactor) {
+        updateOversampling(factor);
     }
+    updateParameterDependents();
+    updateSequencerPattern();
+    updateTuningTable();
+    updateWavetables();
+
+    // PREPARE FOR RENDER LOOP...updates here happen at 44100/frameCount Hz
+    float* outL = (float*)outBufferListPtr->mBuffers[0].mData + bufferOffset;
+    float* outR = (float*)outBufferListPtr->mBuffers[1].mData + bufferOffset;
+
+    // currently UI is visible in DEV panel only so can't be portamento
+
+
+    // Mono <==> Poly switches happen here, at a buffer boundary; the render loop never checks the mode
+    if (parameters[isMono] != previousProcessMonoPolyStatus) {
+        previousProcessMonoPolyStatus = parameters[isMono];
+        beginModeCrossfade(parameters[isMono] > 0.f);
+    }
+    const bool isMonoMode = previousProcessMonoPolyStatus > 0.f;
+
+    // arp/seq step boundaries of this buffer, on the host beat grid while its transport is moving
+    const float hostTempo = mHostTempo.load(std::memory_order_relaxed);
+    S1TransportState transport = {hostTransportIsMoving && hostTempo > 0.f, 0.0, syncTempo() / 60.0 / sampleRate()};
+    if (transport.isMoving) {
+        transport.beatPosition = hostBeatPosition + bufferOffset * transport.beatsPerFrame;
+    }
+    sequencer.beginBlock(parameters, heldNoteNumbersAE, frameCount, transport, *this);
+
+    /// throttle main thread notification to < 30hz
+    processSampleCounter += frameCount;
+    if (processSampleCounter > 2048.0) {
+        playingNotesDidChange();
+        processSampleCounter = 0;
+    }
+    stageStart = mLoadMonitor.mark(S1DSPLoadMonitor::setup, stageStart);
+
+    ///MARK: RENDER LOOP: the frames of the mode crossfade, then the rest of the buffer
+    const AUAudioFrameCount crossfadeFrames = std::min<AUAudioFrameCount>(frameCount, mModeCrossfadeFramesRemaining);
+    if (isMonoMode) {
+        renderFrames<true, true>(0, crossfadeFrames, frameCount, bufferSampleTime, outL, outR, stageStart);
+        renderFrames<true, false>(crossfadeFrames, frameCount, frameCount, bufferSampleTime, outL, outR, stageStart);
+    } else {
+        renderFrames<false, true>(0, crossfadeFrames, frameCount, bufferSampleTime, outL, outR, stageStart);
+        renderFrames<false, false>(crossfadeFrames, frameCount, frameCount, bufferSampleTime, outL, outR, stageStart);
+    }
+    if (mModeCrossfadeFramesRemaining > 0) {
+        mModeCrossfadeFramesRemaining -= crossfadeFrames;
+        if (mModeCrossfadeFramesRemaining == 0) {
+            if (isMonoMode) {
+                clearNoteStates<false>();
+            } else {
+                clearNoteStates<true>();
+            }
+        }
+    }
+
+    // one snapshot per buffer at most, whatever the number of note and beat changes in it
+    publishStateSnapshot();
+    mLoadMonitor.mark(S1DSPLoadMonitor::setup, stageStart);
 }
@@ -0,0 +1,58 @@
+//
+//  S1DSPKernel+reconfigure.mm
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+
+#import "S1DSPKernel.hpp"
+#import "S1NoteState.hpp"
+#import "AEArray.h"
+
+// clear the buffer of delay, which holds its time at the rate of init
+static void resetDelay(sp_delay *delay) {
+    memset(delay->buf.ptr, 0, delay->buf.size);
+    delay->bufpos = 0;
+    delay->last = 0;
+}
+
+void S1DSPKernel::reconfigure(int _channels, double _sampleRate) {
+    assert(mIsInitialized);
+
+    // the effect buffers in the arena are laid out for the sample rate of init
+    if ((int)_sampleRate != sp->sr) {
+        init(_channels, _sampleRate);
+        return;
+    }
+    sp->nchan = _channels;
+    mOversampler.reset();
+    sp_osc_init(sp, panOscillator, sine, 0.f);
+    mCompMaster.updateSampleRate();
+    mCompReverbIn.updateSampleRate();
+    mCompReverbWet.updateSampleRate();
+    mLFOBank.init(_sampleRate);
+
+    // the state of the effects; the caller's restoreValues sets their parameters again.  sp_phaser_init creates a
+    // new Faust instance, so the phaser is created again rather than initialized twice
+    sp_port_init(sp, monoFrequencyPort, 0.05f);
+    sp_phaser_destroy(&phaser0);
+    sp_phaser_create(&phaser0);
+    sp_phaser_init(sp, phaser0);
+    sp_moogladder_init(sp, loPassInputDelayL);
+    sp_moogladder_init(sp, loPassInputDelayR);
+    sp_buthp_init(sp, butterworthHipassL);
+    sp_buthp_init(sp, butterworthHipassR);
+    for (sp_vdelay *delay : {delayL, delayR, delayRR, delayFillIn}) {
+        sp_vdelay_reset(sp, delay);
+    }
+    resetDelay(widenDelay);
+
+    // sp_revsc_init allocates the delay lines again; they return to the room they had
+    initReverb(reverbCostello->aux.ptr);
+
+    [heldNoteNumbers removeAllObjects];
+    [heldNoteNumbersAE updateWithContentsOfArray:heldNoteNumbers];
+    resetRenderState();
+    setRandomSeed(mRandomSeed);
+}
@@ -38,6 +38,31 @@ void S1DSPKernel::reset() {
     sp_vdelay_reset(sp, delayFillIn);
 }
 
+void S1DSPKernel::resetRenderState() {
+    mScheduledEventCount = 0;
+    mRampCount = 0;
+    bitcrushIncr = 1.f;
+    bitcrushIndex = 0.f;
+    bitcrushSampleIndex = 0.f;
+    bitcrushValue = 0.f;
+    monoFrequency = 440.f * exp2((60.f - 69.f) / 12.f);
+    monoFrequencySmooth = monoFrequency;
+    processSampleCounter = 0;
+    mModeCrossfadeFramesRemaining = 0;
+    mModeCrossfadeGain = 0.f;
+    playingNoteStatesIndex = 0;
+    notesHeld = false;
+}
+
+void S1DSPKernel::setRandomSeed(uint32_t seed) {
+    mRandomSeed = seed;
+    sp->rand = seed;
+    if (mIsInitialized) {
+        voiceSp->rand = seed;
+    }
+    sequencer.setRandomSeed(seed);
+}
+
 void S1DSPKernel::resetSequencer() {
 
     // don't remove held notes
@@ -0,0 +1,54 @@
+//
+//  S1DSPKernel+sequencerPattern.mm
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+
+#import "S1DSPKernel.hpp"
+
+void S1DSPKernel::setSequencerPattern(const S1SequencerStep *steps, int count) {
+    S1SequencerPattern& pattern = mSequencerPatterns.back();
+    pattern.usesParameters = false;
+    pattern.stepCount = clamp(count, 0, S1_MAX_SEQUENCER_STEPS);
+    std::copy(steps, steps + pattern.stepCount, pattern.steps.begin());
+    mSequencerPatterns.publish();
+}
+
+void S1DSPKernel::clearSequencerPattern() {
+    S1SequencerPattern& pattern = mSequencerPatterns.back();
+    pattern.usesParameters = true;
+    pattern.stepCount = 0;
+    mSequencerPatterns.publish();
+}
+
+void S1DSPKernel::updateSequencerPattern() {
+
+    // front() stays valid until the next update, so the sequencer reads it in place
+    if (mSequencerPatterns.update()) {
+        const S1SequencerPattern& published = mSequencerPatterns.front();
+        mSequencerPatternIsPublished = !published.usesParameters;
+        if (mSequencerPatternIsPublished) {
+            sequencer.setPattern(&published);
+        } else {
+            mSequencerParametersChanged.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    // parameter and preset changes only rebuild the pattern while no published pattern plays
+    if (mSequencerParametersChanged.exchange(false, std::memory_order_acquire) && !mSequencerPatternIsPublished) {
+        S1SequencerPattern& pattern = mParameterSequencerPattern;
+        pattern.stepCount = clamp((int)parameters[arpTotalSteps], 0, S1_NUM_SEQUENCER_STEPS);
+        for (int i = 0; i < S1_NUM_SEQUENCER_STEPS; i++) {
+            S1SequencerStep& step = pattern.steps[i];
+            step.note = (int)parameters[(S1Parameter)(i + sequencerPattern00)];
+            step.octave = (int)parameters[(S1Parameter)(i + sequencerOctBoost00)];
+            step.velocity = 0; // velocity of the held key
+            step.gate = 1.f;
+            step.probability = 1.f;
+            step.isOn = parameters[(S1Parameter)(i + sequencerNoteOn00)] == 1.f;
+        }
+        sequencer.setPattern(&pattern);
+    }
+}
@@ -9,53 +9,135 @@
 #import "S1DSPKernel.hpp"
 #import "S1NoteState.hpp"
 
-/// tableIndex is on [0, S1_NUM_WAVEFORMS * S1_NUM_BANDLIMITED_FTABLES)
+/// tableIndex is on [0, S1_NUM_WAVETABLES)
 void S1DSPKernel::setupWaveform(uint32_t tableIndex, uint32_t size) {
     tbl_size = size;
-    sp_ftbl_create(sp, &ft_array[tableIndex], tbl_size);
+    if (mOwnedWavetables[tableIndex]) {
+        sp_ftbl_destroy(&mOwnedWavetables[tableIndex]);
+    }
+    sp_ftbl_create(sp, &mOwnedWavetables[tableIndex], tbl_size);
+    ft_array[tableIndex] = mOwnedWavetables[tableIndex];
 }
 
 
 void S1DSPKernel::updateWavetableIncrementValuesForCurrentSampleRate() {
-    
+
+    // tables of a bank keep the increments of its sample rate, which init keeps equal to sp->sr
     double currentSampleIncrement = 1.0 * SP_FT_MAXLEN / sp->sr;
-    for (unsigned int i = 0; i < S1_NUM_WAVEFORMS * S1_NUM_BANDLIMITED_FTABLES; i++) {
-        ft_array[i]->sicvt = currentSampleIncrement;
+    for (sp_ftbl *table : mOwnedWavetables) {
+        if (table) {
+            table->sicvt = currentSampleIncrement;
+        }
+    }
+    if (!mWavetableBank) {
+        sine->sicvt = currentSampleIncrement;
     }
-    sine->sicvt = currentSampleIncrement;
 }
 
-/// tableIndex is on [0, S1_NUM_WAVEFORMS * S1_NUM_BANDLIMITED_FTABLES)
+/// tableIndex is on [0, S1_NUM_WAVETABLES)
 /// sampleIndex is on [0, S1_FTABLE_SIZE)
 void S1DSPKernel::setWaveformValue(uint32_t tableIndex, uint32_t sampleIndex, float value) {
-    ft_array[tableIndex]->tbl[sampleIndex] = value;
+
+    // copy on write: the first change of a bank table makes it this kernel's own.  The render thread may be
+    // reading ft_array, so it switches to the copy itself, at the next buffer
+    if (mWavetableBank && !mOwnedWavetables[tableIndex]) {
+        sp_ftbl *table;
+        sp_ftbl_create(sp, &table, S1_FTABLE_SIZE);
+        const sp_ftbl *bankTable = mWavetableBank->wavetable(tableIndex);
+        std::copy(bankTable->tbl, bankTable->tbl + S1_FTABLE_SIZE, table->tbl);
+        mOwnedWavetables[tableIndex] = table;
+        table->tbl[sampleIndex] = value;
+        mPublishedWavetables[tableIndex].store(table, std::memory_order_release);
+        mHasPublishedWavetables.store(true, std::memory_order_release);
+        return;
+    }
+    mOwnedWavetables[tableIndex]->tbl[sampleIndex] = value;
+}
+
+void S1DSPKernel::updateWavetables() {
+    if (!mHasPublishedWavetables.exchange(false, std::memory_order_acquire)) {
+        return;
+    }
+    for (int i = 0; i < S1_NUM_WAVETABLES; i++) {
+        if (sp_ftbl *table = mPublishedWavetables[i].exchange(nullptr, std::memory_order_acquire)) {
+            ft_array[i] = table;
+        }
+    }
 }
 
 void S1DSPKernel::setBandlimitFrequency(uint32_t blIndex, float frequency) {
     ft_frequencyBand[blIndex] = frequency;
 }
 
+void S1DSPKernel::setWavetableBank(std::shared_ptr<const S1WavetableBank> bank) {
+    assert(!initializedNoteStates);
+
+    // bank replaces every table, including those changed by setWaveformValue
+    for (std::atomic<sp_ftbl *> &table : mPublishedWavetables) {
+        table.store(nullptr, std::memory_order_relaxed);
+    }
+    for (sp_ftbl *&table : mOwnedWavetables) {
+        if (table) {
+            sp_ftbl_destroy(&table);
+            table = nullptr;
+        }
+    }
+    std::copy(bank->bandlimitFrequencies(), bank->bandlimitFrequencies() + S1_NUM_BANDLIMITED_FTABLES, ft_frequencyBand);
+    if (bank->sampleRate() != sampleRate()) {
+        bank = S1WavetableBank::shared(sampleRate(), *bank);
+    }
+    bindWavetableBank(std::move(bank));
+}
+
+void S1DSPKernel::bindWavetableBank(std::shared_ptr<const S1WavetableBank> bank) {
+    for (int i = 0; i < S1_NUM_WAVETABLES; i++) {
+        if (!mOwnedWavetables[i]) {
+            ft_array[i] = bank->wavetable(i);
+        }
+    }
+
+    // the sine of an initialized kernel without a bank is its own; init takes the sine of the bank otherwise
+    if (mIsInitialized) {
+        if (!mWavetableBank) {
+            sp_ftbl_destroy(&sine);
+        }
+        sine = bank->sine();
+        sp_osc_init(sp, panOscillator, sine, 0.f);
+    }
+    mWavetableBank = std::move(bank);
+}
+
 // initializeNoteStates() must be called AFTER init returns
 void S1DSPKernel::initializeNoteStates() {
     if (initializedNoteStates == false) {
         initializedNoteStates = true;
+
+        // the modules of the previous note states are overwritten; none of them allocates
+        mArena.rewind(mVoiceArenaMark);
+
         // POLY INIT
         for (int i = 0; i < S1_MAX_POLYPHONY; i++) {
             S1NoteState& state = (*noteStates)[i];
             state.kernel = this;
-            state.init();
-            state.stage = S1NoteState::stageOff;
-            state.internalGate = 0;
-            state.rootNoteNumber = -1;
-            state.transpose = 0;
+            state.init(mArena);
+            state.clear();
         }
 
         // MONO INIT
         monoNote->kernel = this;
-        monoNote->init();
-        monoNote->stage = S1NoteState::stageOff;
-        monoNote->internalGate = 0;
-        monoNote->rootNoteNumber = -1;
-        monoNote->transpose = 0;
+        monoNote->init(mArena);
+        monoNote->clear();
     }
 }
+
+// switch the voice rate; called by process at a buffer boundary
+void S1DSPKernel::updateOversampling(int factor) {
+    oversamplingFactor = factor;
+    oversamplingFrequencyScale = 1.f / factor;
+    oversamplingNoiseGain = sqrtf(factor);
+    voiceSp->sr = sampleRate() * factor;
+    mOversampler.reset();
+    for (int i = 0; i < S1_MAX_POLYPHONY; i++)
+        (*noteStates)[i].updateSampleRate();
+    monoNote->updateSampleRate();
+}
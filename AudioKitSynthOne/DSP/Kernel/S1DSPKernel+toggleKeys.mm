@@ -32,10 +32,8 @@ void S1DSPKernel::turnOnKey(int noteNumber, int velocity, float frequency) {
 
         // PORTAMENTO: set the ADSRs to release mode here, then into attack mode inside startNoteHelper
         if (parameters[monoIsLegato] == 0) {
-            note.internalGate = 0;
             note.stage = S1NoteState::stageRelease;
-            sp_adsr_compute(sp, note.adsr, &note.internalGate, &note.amp);
-            sp_adsr_compute(sp, note.fadsr, &note.internalGate, &note.filter);
+            note.gateOff();
         }
 
         // legato+portamento: Legato means that Presets with low sustains will sound like they did not retrigger.
@@ -96,7 +94,7 @@ void S1DSPKernel::turnOffKey(int noteNumber) {
             // the case where the sequencer turns off this key even though a note is held down
             if (monoNote->stage != S1NoteState::stageOff) {
                 monoNote->stage = S1NoteState::stageRelease;
-                monoNote->internalGate = 0;
+                monoNote->gateOff();
             }
         } else {
 
@@ -104,33 +102,22 @@ void S1DSPKernel::turnOffKey(int noteNumber) {
             AEArrayToken token = AEArrayGetToken(heldNoteNumbersAE);
             NoteNumber* nn = (NoteNumber*)AEArrayGetItem(token, 0);
 
-            // This logic is in S1NoteState::startNoteHelper...need a common function
             const int headNN = nn->noteNumber;
             monoNote->rootNoteNumber = headNN;
             monoNote->transpose = (int)parameters[transpose];
-            monoNote->velocity = nn->velocity;
-            monoNote->amp = (float)pow2(nn->velocity / 127.f);
-            monoNote->oscmorph1->amp = monoNote->amp;
-            monoNote->oscmorph2->amp = monoNote->amp;
-            monoNote->subOsc->amp = monoNote->amp;
-            monoNote->fmOsc->amp = monoNote->amp;
+            monoNote->setVelocity(nn->velocity);
             monoFrequency = tuningTableNoteToHz(headNN + (int)parameters[transpose]);
-            monoNote->oscmorph1->freq = monoFrequency;
-            monoNote->oscmorph2->freq = monoFrequency;
-            monoNote->subOsc->freq = monoFrequency;
-            monoNote->fmOsc->freq = monoFrequency;
+            monoNote->noteFrequency = monoFrequency;
 
             // PORTAMENTO: reset the ADSR inside the render loop
             if (parameters[monoIsLegato] == 0.f) {
-                monoNote->internalGate = 0;
                 monoNote->stage = S1NoteState::stageRelease;
-                sp_adsr_compute(sp, monoNote->adsr, &monoNote->internalGate, &monoNote->amp);
-                sp_adsr_compute(sp, monoNote->fadsr, &monoNote->internalGate, &monoNote->filter);
+                monoNote->gateOff();
             }
 
             // legato+portamento: Legato means that Presets with low sustains will sound like they did not retrigger.
             monoNote->stage = S1NoteState::stageOn;
-            monoNote->internalGate = 1;
+            monoNote->gateOn();
         }
     } else {
 
@@ -149,9 +136,7 @@ void S1DSPKernel::turnOffKey(int noteNumber) {
             S1NoteState& note = (*noteStates)[index];
             if (note.stage != S1NoteState::stageOff) {
                 note.stage = S1NoteState::stageRelease;
-                note.internalGate = 0;
-                sp_adsr_compute(sp, note.adsr, &note.internalGate, &note.amp);
-                sp_adsr_compute(sp, note.fadsr, &note.internalGate, &note.filter);
+                note.gateOff();
             }
         } else {
 
@@ -0,0 +1,104 @@
+//
+//  S1DSPKernel+tuningTable.mm
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+
+#import <AudioKit/AudioKit-Swift.h>
+#import "S1DSPKernel.hpp"
+#import "S1NoteState.hpp"
+#import "S1Scala.hpp"
+
+// private tuningTable lookup
+double S1DSPKernel::tuningTableNoteToHz(double noteNumber) {
+    return mTuningTable.load(std::memory_order_acquire)->frequency(noteNumber);
+}
+
+void S1DSPKernel::setTuningTable(const S1TuningTable &table, bool retune) {
+    if (table.count < 1 || table.count > S1_MAX_TUNING_TABLE_NOTES) {
+        return;
+    }
+    if (&table != &mMainTuningTable) {
+        mMainTuningTable = table;
+    }
+    mTuningTables.back() = mMainTuningTable;
+    if (retune) {
+        mRetuneSoundingNotes.store(true, std::memory_order_relaxed);
+    }
+    mTuningTables.publish();
+    sequencer.setNotesPerOctave(mMainTuningTable.notesPerOctave);
+}
+
+void S1DSPKernel::setTuningTable(const float *frequencies, int count, int firstNote, bool retune) {
+    if (count < 1 || count > S1_MAX_TUNING_TABLE_NOTES) {
+        return;
+    }
+    mMainTuningTable.firstNote = firstNote;
+    mMainTuningTable.count = count;
+    std::copy(frequencies, frequencies + count, mMainTuningTable.frequencies.begin());
+    setTuningTable(mMainTuningTable, retune);
+}
+
+bool S1DSPKernel::setScalaTuning(const std::string &scl, const std::string &kbm, bool retune) {
+    const std::optional<S1ScalaScale> scale = S1ParseScalaScale(scl);
+    const std::optional<S1ScalaKeyboardMapping> mapping = kbm.empty() ? S1ScalaKeyboardMapping() : S1ParseScalaKeyboardMapping(kbm);
+    if (!scale || !mapping) {
+        return false;
+    }
+    S1TuningTable table;
+    if (!S1ScalaTuningTable(*scale, *mapping, table)) {
+        return false;
+    }
+    setTuningTable(table, retune);
+    return true;
+}
+
+// RENDER THREAD: called by process at the start of each buffer
+void S1DSPKernel::updateTuningTable() {
+    if (!mTuningTables.update()) {
+        return;
+    }
+    mTuningTable.store(&mTuningTables.front(), std::memory_order_release);
+    if (!mRetuneSoundingNotes.exchange(false, std::memory_order_acquire) || !initializedNoteStates) {
+        return;
+    }
+
+    // the voice frequency caches pick up the new noteFrequency on the next frame
+    if (parameters[isMono] > 0.f) {
+        if (monoNote->stage != S1NoteState::stageOff) {
+            monoFrequency = tuningTableNoteToHz(monoNote->rootNoteNumber + monoNote->transpose);
+            monoNote->noteFrequency = monoFrequency;
+        }
+    } else {
+        for (int i = 0; i < polyphony; i++) {
+            S1NoteState& note = (*noteStates)[i];
+            if (note.rootNoteNumber != -1) {
+                note.noteFrequency = tuningTableNoteToHz(note.rootNoteNumber + note.transpose);
+            }
+        }
+    }
+}
+
+// S1TuningTable protocol
+void S1DSPKernel::setTuningTable(float frequency, int index) {
+    const int i = index - mMainTuningTable.firstNote;
+    if (i < 0 || i >= mMainTuningTable.count) {
+        printf("setTuningTable: note %d is outside the tuning table, notes %d...%d\n",
+               index, mMainTuningTable.firstNote, mMainTuningTable.firstNote + mMainTuningTable.count - 1);
+        return;
+    }
+    mMainTuningTable.frequencies[i] = frequency;
+    setTuningTable(mMainTuningTable, false);
+}
+
+float S1DSPKernel::getTuningTableFrequency(int index) {
+    const int i = clamp(index - mMainTuningTable.firstNote, 0, mMainTuningTable.count - 1);
+    return mMainTuningTable.frequencies[i];
+}
+
+void S1DSPKernel::setTuningTableNPO(int npo) {
+    mMainTuningTable.notesPerOctave = npo;
+    sequencer.setNotesPerOctave(npo);
+}
@@ -10,8 +10,9 @@
 #pragma once
 
 #import <array>
+#import <atomic>
+#import <memory>
 #import <vector>
-#import <list>
 #import <optional>
 #import <string>
 #import "AudioKit/AKSoundpipeKernel.hpp"
@@ -19,18 +20,29 @@
 #import "S1Parameter.h"
 #import "S1Rate.hpp"
 #import "../Sequencer/S1Sequencer.hpp"
+#import "S1DSPArena.hpp"
 #import "S1DSPCompressor.hpp"
+#import "S1DSPLoadMonitor.hpp"
+#import "S1Envelope.hpp"
+#import "S1Oversampler.hpp"
+#import "S1ModulationMatrix.hpp"
+#import "S1ParameterEventQueue.hpp"
+#import "S1ParameterTable.hpp"
+#import "S1StateSnapshot.hpp"
+#import "S1TuningTable.hpp"
+#import "S1WavetableBank.hpp"
 
 @class AEArray;
-@class AEMessageQueue;
 
-#define S1_FTABLE_SIZE (4096)
-#define S1_NUM_WAVEFORMS (4)
-#define S1_NUM_BANDLIMITED_FTABLES (13)
-
-#define S1_RELEASE_AMPLITUDE_THRESHOLD (0.01f)
 #define S1_PORTAMENTO_HALF_TIME (0.1f)
 #define S1_DEPENDENT_PARAM_TAPER (0.4f)
+#define S1_MAX_SCHEDULED_PARAMETER_EVENTS (256)
+#define S1_MAX_PARAMETER_RAMPS (32)
+#define S1_MODE_CROSSFADE_SECONDS (0.005f)
+#define S1_MAX_DELAY_SECONDS (10.f)
+#define S1_WIDEN_DELAY_SECONDS (0.05f)
+// smoothed generator volume below which a generator whose volume is heading for 0 stops running, -100 dB
+#define S1_SILENT_GENERATOR_VOLUME (1.0e-5f)
 
 #ifdef __cplusplus
 
@@ -39,6 +51,9 @@ class S1Sequencer;
 using DSPParameters = std::array<float, S1Parameter::S1ParameterCount>;
 using NoteStateArray = std::array<S1NoteState, S1_MAX_POLYPHONY>;
 
+// S1NoteState::Renderer
+using S1VoiceRenderer = void (S1NoteState::*)(int frameIndex, int lfoFrameIndex, float *outL, float *outR);
+
 class S1DSPKernel : public AKSoundpipeKernel, public AKOutputBuffered {
 
     // MARK: S1DSPKernel Member Functions
@@ -62,13 +77,29 @@ public:
         return sp->sr;
     }
 
+    // sp_data of the per-voice oscillator+filter path, at oversamplingFactor * sampleRate()
+    inline sp_data *voiceSpp() {
+        return voiceSp;
+    }
+
     float getSynthParameter(S1Parameter param);
     void setSynthParameter(S1Parameter param, float value);
 
+    // ANY THREAD: queue a parameter change for the render thread, which applies it at sampleTime
+    // (AUEventSampleTimeImmediate: start of the next buffer) ramping over rampDuration frames.
+    // Falls back to setSynthParameter if the queue is full.
+    void postSynthParameter(S1Parameter param, float value,
+                            AUEventSampleTime sampleTime = AUEventSampleTimeImmediate,
+                            AUAudioFrameCount rampDuration = 0);
+
     // lfo1Rate, lfo2Rate, autoPanRate, delayTime, and arpSeqTempoMultiplier; returns on [0,1]
     float getDependentParameter(S1Parameter param);
     void setDependentParameter(S1Parameter param, float value, int payload);
 
+    // Resolve a complete preset on the calling (main) thread and publish it to the render thread,
+    // which applies all values at once at the start of the next buffer
+    void loadPreset(const DSPParameters &preset);
+
     // AUParameter/AUValue
     void setParameters(float params[]);
     
@@ -84,10 +115,22 @@ public:
     ///puts all notes in release mode...no artifacts
     void stopAllNotes();
     
+    // RENDER THREAD: host tempo, or 0 if the host provides none.  When it changes the tempo-synced rates are recomputed
     void handleTempoSetting(float currentTempo);
+
+    // ANY THREAD: tempo of the arp/seq and the tempo-synced rates: the host tempo while the host provides one, else arpRate
+    float syncTempo() const;
     
     ///PROCESS
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override;
+
+    // sample time of frame 0 of the current render cycle; set by the render block before processWithEvents
+    AUEventSampleTime renderSampleTime = 0;
+
+    // host transport state and beat position at frame 0 of the current render cycle; set by the render block before processWithEvents.
+    // The sequencer follows the host beat while its transport is moving
+    bool hostTransportIsMoving = false;
+    double hostBeatPosition = 0;
     
     // turnOnKey is called by render thread in "process", so access note via AEArray
     void turnOnKey(int noteNumber, int velocity);
@@ -120,6 +163,19 @@ public:
     
     void init(int _channels, double _sampleRate) override;
 
+    // init reports running out of memory by leaving the kernel uninitialized
+
+    // init of an initialized kernel without rebuilding it: the arena and the modules in it are kept, the state of
+    // every module, the effect buffers, the held notes, scheduled events and ramps are cleared.  At another sample
+    // rate than init's it runs init, since the arena is laid out for that rate.  Unlike init it leaves the parameters
+    // to the caller: DSP state restarts as after init once the caller calls restoreValues.  MAIN THREAD, while not
+    // rendering
+    void reconfigure(int _channels, double _sampleRate);
+
+    bool isInitialized() const {
+        return mIsInitialized;
+    }
+
     // Restore Parameter Values to DSP
     void restoreValues(std::optional<DSPParameters> params);
     
@@ -136,6 +192,11 @@ public:
 
     void setBandlimitFrequency(uint32_t blIndex, float frequency);
 
+    // Read the waveforms, band frequencies and sine from bank, shared with other kernels, instead of tables of this
+    // kernel.  setWaveformValue then copies a table before its first change.  init moves to the bank of the same
+    // tables at the new sample rate.  MAIN THREAD, while not rendering
+    void setWavetableBank(std::shared_ptr<const S1WavetableBank> bank);
+
     ///parameter min
     float minimum(S1Parameter i);
     
@@ -165,11 +226,8 @@ private:
     // moved the private functions to try to get rid of errors, I don't think we need to be that worried about privacy
     S1Sequencer sequencer;
 
-    // phasor values
-    float lfo1Smooth = 0.f;
-    float lfo2Smooth = 0.f;
-    sp_port *lfo1Port;
-    sp_port *lfo2Port;
+    // sequencer.process calls back turnOnKey, turnOffKey and beatCounterDidChange
+    friend class S1Sequencer;
 
     // Keep track on when and when not to call destroy()
     bool mIsInitialized = false;
@@ -185,6 +243,9 @@ public:
 
     void _rateHelper(S1Parameter param, float inputValue, bool notifyMainThread, int payload);
 
+    // resolve lfo1Rate, lfo2Rate, autoPanFrequency and delayTime against syncTempo
+    void updateTempoSyncedRates(bool notifyMainThread, int payload);
+
     // algebraic only
     float taper01(float inputValue01, float taper);
     float taper01Inverse(float inputValue01, float taper);
@@ -194,6 +255,10 @@ public:
     float taperInverse(float inputValue01, float min, float max, float taper);
 
     __weak S1AudioUnit* audioUnit;
+
+    // false for a kernel whose dependent parameter changes no main thread polls, e.g. an offline renderer's:
+    // they are not queued
+    bool publishesDependentParameterChanges = true;
     
     bool resetted = false;
     
@@ -208,35 +273,210 @@ public:
     // midi
     bool notesHeld = false;
     
-    PlayingNotes aePlayingNotes;
-    
-    HeldNotes aeHeldNotes;
-
-    sp_ftbl *ft_array[S1_NUM_WAVEFORMS * S1_NUM_BANDLIMITED_FTABLES];
+    sp_ftbl *ft_array[S1_NUM_WAVETABLES];
     float   ft_frequencyBand[S1_NUM_BANDLIMITED_FTABLES];
 
     sp_ftbl *sine;
     
-    float lfo1_0_1 = 0.f;
-    float lfo1_1_0 = 0.f;
-    float lfo2_0_1 = 0.f;
-    float lfo2_1_0 = 0.f;
-    float lfo3_0_1 = 0.f;
-    float lfo3_1_0 = 0.f;
+    // LFO routing of voices and effects; recompiled by process when a routing parameter changes.
+    // Reads the current control block of mLFOBank
+    S1ModulationMatrix modulationMatrix;
     
     float monoFrequencySmooth = 261.6255653006f;
 
-    // S1TuningTable protocol
+    // frequency ratios common to all voices; recomputed by process only when their parameters change.
+    // version is bumped on every change so voices can tell when their frequency cache is stale
+    struct PitchRatios {
+        float osc1 = 1.f;      // morph1SemitoneOffset
+        float osc2 = 1.f;      // morph2SemitoneOffset
+        float sub = 0.5f;      // subOctaveDown
+        float pitchbend = 1.f; // pitchbend, pitchbendMinSemitones, pitchbendMaxSemitones
+        uint32_t version = 0;
+    };
+    PitchRatios pitchRatios;
+
+    // poles of the amplitude and filter envelopes of every voice; updated by updateParameterDependents
+    S1Envelope::Shape ampEnvelopeShape;
+    S1Envelope::Shape filterEnvelopeShape;
+
+    // voices render at oversamplingFactor * sampleRate().  Wavetable increments are relative to the host rate,
+    // so oscillator frequencies are scaled by oversamplingFrequencyScale.
+    // Decimation removes the noise above the host Nyquist, oversamplingNoiseGain restores its level
+    int oversamplingFactor = 1;
+    float oversamplingFrequencyScale = 1.f;
+    float oversamplingNoiseGain = 1.f;
+
+    // MAIN THREAD: replace the sequencer pattern; the render thread switches to it at the next buffer.
+    // It plays until clearSequencerPattern, whatever the sequencer parameters and presets
+    void setSequencerPattern(const S1SequencerStep *steps, int count);
+
+    // MAIN THREAD: return to the pattern of the sequencer parameters
+    void clearSequencerPattern();
+
+    // MAIN THREAD: copy of the latest state published by the render thread.
+    // Returns false if nothing was published since the last call
+    bool readStateSnapshot(S1StateSnapshot &snapshot);
+
+    // MAIN THREAD: next dependent parameter change, oldest first.  Returns false if there are none
+    bool popDependentParameterChange(DependentParameter &param);
+
+    // MAIN THREAD: number of dependent parameter changes lost to a full queue since the last call
+    uint32_t takeDroppedDependentParameterChanges();
+
+    // RENDER THREAD: bracket each render cycle, i.e. all process() calls of one render block call
+    void beginRenderCycle();
+    void endRenderCycle(AUAudioFrameCount frameCount);
+
+    // MAIN THREAD: latest DSP load.  Returns false if nothing was published since the last call
+    bool readDSPLoad(S1DSPLoad &load);
+
+    // ANY THREAD: restart the DSP load totals and peaks at the next render cycle
+    void resetDSPLoad();
+
+    // MAIN THREAD, while not rendering: seed sp_rand of both sp_data, which drives the voices' sp_noise, and the
+    // sequencer's step probability.  Kept across init, so rendering from freshly allocated render resources
+    // repeats exactly.  sp_revsc modulates its delay lines from fixed seeds set by sp_revsc_init.
+    // Seed 0 is the default
+    void setRandomSeed(uint32_t seed);
+
+    // S1TuningTable protocol.  MAIN THREAD: each call publishes the whole table.
+    // setTuningTable ignores a note number outside the current table
     void setTuningTable(float value, int index);
     float getTuningTableFrequency(int index);
     void setTuningTableNPO(int npo);
 
+    // MAIN THREAD: replace the tuning table; the render thread switches to it at the next buffer.
+    // retune: sounding notes move to the new table, otherwise only notes started afterwards use it
+    void setTuningTable(const S1TuningTable &table, bool retune);
+
+    // MAIN THREAD: frequencies of note numbers firstNote...firstNote + count - 1, count <= S1_MAX_TUNING_TABLE_NOTES.
+    // Keeps the notes per octave of the current table
+    void setTuningTable(const float *frequencies, int count, int firstNote, bool retune);
+
+    // MAIN THREAD: tuning table of a Scala scale and keyboard mapping; an empty kbm maps the scale linearly
+    // with degree 0 at middle C.  Returns false and keeps the current table if either file is malformed
+    bool setScalaTuning(const std::string &scl, const std::string &kbm, bool retune);
+
 private:
-    std::array<std::atomic<float>, 128> tuningTable;
-    std::atomic<int> tuningTableNPO{12};
+    // main thread's copy of the published table, edited by the S1TuningTable protocol
+    S1TuningTable mMainTuningTable;
+
+    // tables published by setTuningTable.  mTuningTable points at the front buffer, which the
+    // render thread swaps in at a buffer boundary; main thread lookups read it too, which is safe
+    // because only the main thread publishes, and a buffer is rewritten only after a later publish
+    S1TripleBuffer<S1TuningTable> mTuningTables;
+    std::atomic<const S1TuningTable *> mTuningTable {nullptr};
+    std::atomic<bool> mRetuneSoundingNotes {false};
+
+    // switch to the latest published table; called by process at a buffer boundary
+    void updateTuningTable();
+
+    // private tuningTable lookup; fractional note numbers fall between table entries
+    double tuningTableNoteToHz(double noteNumber);
+
+    // render the playing mono (IsMono) or poly NoteStates into frame "frameIndex" of (outL, outR)
+    template <bool IsMono>
+    inline void renderVoices(int frameIndex, int lfoFrameIndex, float *outL, float *outR);
+
+    // renderVoices of the current mode and, while IsCrossfading, the voices of the previous mode fading out
+    template <bool IsMono, bool IsCrossfading>
+    inline void renderNoteStates(int frameIndex, int lfoFrameIndex, float *outL, float *outR);
+
+    template <bool IsMono>
+    void clearNoteStates();
+
+    // the render loop over frames [frameBegin, frameEnd) of a buffer of frameCount frames.
+    // Mono and poly, with and without the mode crossfade, are separate instantiations chosen once per buffer
+    template <bool IsMono, bool IsCrossfading>
+    void renderFrames(AUAudioFrameCount frameBegin, AUAudioFrameCount frameEnd, AUAudioFrameCount frameCount,
+                      AUEventSampleTime bufferSampleTime, float *outL, float *outR, S1DSPLoadMonitor::Ticks &stageStart);
+
+    // mono <=> poly switch at a buffer boundary: the voices of the previous mode fade out over
+    // S1_MODE_CROSSFADE_SECONDS, then are cleared
+    void beginModeCrossfade(bool isMonoMode);
+
+    // switch the voice rate; called by process at a buffer boundary
+    void updateOversampling(int factor);
+
+    // RENDER THREAD: parameter events posted by postSynthParameter, and host ramps
+    void drainParameterEvents(AUEventSampleTime sampleTime);
+    void processParameterEvents(AUEventSampleTime sampleTime);
+    void applyParameterEvent(const S1ParameterEvent &event);
+    void startParameterRamp(S1Parameter param, float value, AUAudioFrameCount duration);
+
+    S1ParameterEventQueue mParameterEventQueue;
 
-    // private tuningTable lookup
-    double tuningTableNoteToHz(int noteNumber);
+    // serial of the last posted event.  Events up to mStaleEventSerial were posted before the last applied preset
+    std::atomic<uint32_t> mParameterEventSerial {0};
+    uint32_t mStaleEventSerial = 0;
+
+    // drop the scheduled events and ramps of parameter changes posted before the preset of serial presetSerial
+    void discardParameterEvents(uint32_t presetSerial);
+
+    // latest posted value and number of posted events not yet applied, so getSynthParameter
+    // reflects a posted change before the render thread picks it up
+    std::array<std::atomic<float>, S1Parameter::S1ParameterCount> mPostedValues {};
+    std::array<std::atomic<uint32_t>, S1Parameter::S1ParameterCount> mPostedEventCounts {};
+
+    // posted changes the full queue could not take: the serial of the latest, 0 if none.  The render thread applies
+    // mPostedValues of these parameters at the next buffer, so a change is never written from the posting thread
+    std::array<std::atomic<uint32_t>, S1Parameter::S1ParameterCount> mCoalescedEventSerials {};
+    std::atomic<bool> mHasCoalescedEvents {false};
+    void drainCoalescedParameterEvents();
+
+    // future events sorted by sampleTime
+    std::array<S1ParameterEvent, S1_MAX_SCHEDULED_PARAMETER_EVENTS> mScheduledEvents;
+    int mScheduledEventCount = 0;
+
+    struct ParameterRamp {
+        S1Parameter parameter;
+        float value;
+        float increment;
+        float target;
+        AUAudioFrameCount framesRemaining;
+    };
+    std::array<ParameterRamp, S1_MAX_PARAMETER_RAMPS> mRamps;
+    int mRampCount = 0;
+
+    // hand the sequencer the latest pattern; called by process at a buffer boundary
+    void updateSequencerPattern();
+
+    // patterns published by setSequencerPattern and clearSequencerPattern
+    S1TripleBuffer<S1SequencerPattern> mSequencerPatterns;
+
+    // the sequencer plays a pattern of setSequencerPattern, not mParameterSequencerPattern
+    bool mSequencerPatternIsPublished = false;
+
+    // pattern of arpTotalSteps and the sequencerPattern, sequencerOctBoost, sequencerNoteOn parameters.
+    // Rebuilt by updateSequencerPattern when one of them changed
+    S1SequencerPattern mParameterSequencerPattern;
+    std::atomic<bool> mSequencerParametersChanged {true};
+
+    // apply a preset published by loadPreset; called by process at a buffer boundary.
+    // Returns true if a preset was applied
+    bool applyPendingPreset();
+
+    // loadPreset handoff.  The main thread owns mPendingPreset while the slot is Free or Writing,
+    // the render thread while it is Reading.
+    enum PresetSlotState : int { PresetSlotFree, PresetSlotWriting, PresetSlotReady, PresetSlotReading };
+    std::atomic<int> mPresetSlotState {PresetSlotFree};
+    DSPParameters mPendingPreset;
+    uint32_t mPendingPresetSerial = 0; // mParameterEventSerial when mPendingPreset was published
+
+    // recompute pitchRatios if any of its parameters changed
+    void updatePitchRatios();
+
+    // state derived from parameters: pitchRatios, the modulation matrix, the voice renderers and envelope shapes.
+    // Called by process at a buffer boundary and after every parameter event or ramp step inside the buffer
+    void updateParameterDependents();
+
+    // S1NoteState::Generator bits of the voice generators that run
+    int audibleGenerators();
+    std::array<float, 6> pitchRatioInputs {{NAN, NAN, NAN, NAN, NAN, NAN}};
+
+    sp_data *voiceSp;
+    S1Oversampler mOversampler;
+    S1LFOBank mLFOBank;
 
     // setup parameter tree with values or default
     void setupParameterTree(std::optional<DSPParameters> params);
@@ -255,35 +495,95 @@ private:
 
     DependentParameter _arpSeqTempoMultiplier;
     
+    ///can be called from any thread
     void dependentParameterDidChange(DependentParameter param);
 
-    ///can be called from within the render loop
+    ///can be called from any thread; marks the state dirty for the next publishStateSnapshot
     void beatCounterDidChange();
     
-    ///can be called from within the render loop
+    ///can be called from any thread; marks the state dirty for the next publishStateSnapshot
     void playingNotesDidChange();
     
-    ///can be called from within the render loop
+    ///can be called from any thread; marks the state dirty for the next publishStateSnapshot
     void heldNotesDidChange();
+
+    // RENDER THREAD: publish the UI state if any of it changed; called by process at the end of each buffer
+    void publishStateSnapshot();
+
+    enum StateChange : uint32_t {
+        StateChangeHeldNotes = 1 << 0,
+        StateChangeBeatCounter = 1 << 1,
+        StateChangePlayingNotes = 1 << 2
+    };
+    std::atomic<uint32_t> mStateChanges {0};
+
+    // render thread copy of the published state; mStateSnapshots holds the buffers shared with the main thread
+    S1StateSnapshot mState;
+    S1TripleBuffer<S1StateSnapshot> mStateSnapshots;
+
+    // stage timing of process(), published once per render cycle
+    S1DSPLoadMonitor mLoadMonitor;
+
+    // applied to sp, voiceSp and the sequencer by setRandomSeed and init
+    uint32_t mRandomSeed = 0;
+
+    // owner of sine and of the ft_array tables that are not in mOwnedWavetables when set; otherwise the kernel
+    // owns sine, created by init and destroyed by destroy
+    std::shared_ptr<const S1WavetableBank> mWavetableBank;
+
+    // tables of setupWaveform, and copies of bank tables changed by setWaveformValue; freed by the destructor
+    std::array<sp_ftbl *, S1_NUM_WAVETABLES> mOwnedWavetables {};
+
+    // copies of bank tables made by setWaveformValue, not yet in ft_array; nullptr for the other tables
+    std::array<std::atomic<sp_ftbl *>, S1_NUM_WAVETABLES> mPublishedWavetables {};
+    std::atomic<bool> mHasPublishedWavetables {false};
+
+    // point ft_array at the tables published by setWaveformValue; called by process at a buffer boundary
+    void updateWavetables();
+
+    // point the ft_array tables that are not owned, and sine, at bank
+    void bindWavetableBank(std::shared_ptr<const S1WavetableBank> bank);
+
+    // dependent parameter changes from any thread to the main thread poll
+    S1MPSCQueue<DependentParameter, 256> mDependentParameterChanges;
+    std::atomic<uint32_t> mDroppedDependentParameterChanges {0};
     
-    struct S1ParameterInfo {
-        S1Parameter parameter;
-        float minimum;
-        float defaultValue;
-        float maximum;
-        std::string presetKey;
-        std::string friendlyName;
-        AudioUnitParameterUnit unit;
-        bool usePortamento;
+    // smoothing state of a parameter that uses portamento; metadata is in S1ParameterTable
+    struct S1PortamentoState {
         sp_port *portamento;
         float portamentoTarget;
     };
 
-    // array of struct S1NoteState of count MAX_POLYPHONY
-    std::unique_ptr<NoteStateArray> noteStates;
+    // indexed by S1Portamento.index
+    std::array<S1PortamentoState, S1PortamentoParameters::kCount> portamentoStates;
+
+    // smoothing state of param, or nullptr if param does not use portamento
+    inline S1PortamentoState *portamentoState(S1Parameter param) {
+        const int index = S1Portamento.index[param];
+        return index < 0 ? nullptr : &portamentoStates[index];
+    }
+
+    // Soundpipe modules, except the phaser, the buffers of the delays and the reverb, and the note states; carved
+    // by init and initializeNoteStates.  Sized by arenaFootprint for the sample rate of init
+    S1DSPArena mArena;
+
+    // start of the modules of the note states, carved again whenever initializeNoteStates runs
+    size_t mVoiceArenaMark = 0;
+
+    static size_t arenaFootprint(int sampleRate);
+
+    // move a buffer a Soundpipe init just allocated into room, or into room carved from mArena if room is null.
+    // Without room in the arena the buffer stays where it is, and destroy frees it
+    void moveToArena(sp_auxdata &aux, void *room = nullptr);
+
+    // sp_revsc_init, with the delay lines in room, or in room carved from mArena if room is null
+    void initReverb(void *room = nullptr);
+
+    // array of struct S1NoteState of count MAX_POLYPHONY, in mArena
+    NoteStateArray *noteStates = nullptr;
     
-    // monophonic: single instance of NoteState
-    std::unique_ptr<S1NoteState> monoNote;
+    // monophonic: single instance of NoteState, in mArena
+    S1NoteState *monoNote = nullptr;
     
     bool initializedNoteStates = false;
     
@@ -294,8 +594,6 @@ private:
     
     int playingNoteStatesIndex = 0;
     UInt32 tbl_size = S1_FTABLE_SIZE;
-    sp_phasor *lfo1Phasor;
-    sp_phasor *lfo2Phasor;
     sp_pan2 *pan;
     sp_osc *panOscillator;
     sp_phaser *phaser0;
@@ -325,198 +623,32 @@ private:
     sp_compressor *compressorReverbWetR;
     sp_delay *widenDelay;
     sp_port *monoFrequencyPort;
-    float tempo = 120.f;
+    // host tempo, bpm; 0 without a host musical context.  Kept apart from arpRate, which stays the preset's
+    std::atomic<float> mHostTempo {0.f};
     float previousProcessMonoPolyStatus = 0.f;
+
+    // specializations of S1NoteState::run for this buffer's filter type and audible generators; poly, then mono
+    std::array<S1VoiceRenderer, 2> mVoiceRenderers {};
+
+    // host frames left of the mode crossfade, and the gain of the voices of the previous mode
+    int mModeCrossfadeFramesRemaining = 0;
+    float mModeCrossfadeGain = 0.f;
+    float mModeCrossfadeStep = 0.f;
     float bitcrushIncr = 1.f;
     float bitcrushIndex = 0.f;
     float bitcrushSampleIndex = 0.f;
     float bitcrushValue = 0.f;
 
-    // Count samples to limit main thread notification
+    // Count samples to limit playing notes snapshots
     double processSampleCounter = 0;
-    
-    ///once init'd: sequencerLastNotes can be accessed and mutated only within process and resetDSP
-    std::list<int> sequencerLastNotes;
+
+    // clear the render state outside the DSP modules: scheduled events, ramps, bitcrush, mono frequency, crossfade.
+    // Called by init and reconfigure
+    void resetRenderState();
 
     
     // Array of midi note numbers of NoteState's which have had a noteOn event but not yet a noteOff event.
     NSMutableArray<NSValue*>* heldNoteNumbers;
     AEArray* heldNoteNumbersAE;
-
-    // These expressions come from Rate.swift which is used for beat sync
-    const float minutesPerSecond = 1.f / 60.f;
-    const float beatsPerBar = 4.f;
-    const float bpm_min = 1.f;
-    const float bpm_max = 200.f;
-    const float bars_min = 1.f / 64.f / 1.5f;
-    const float bars_max = 8.f;
-    const float rate_min = 1.f / ( (beatsPerBar * bars_max) / (bpm_min * minutesPerSecond) ); //  0.00052 8 bars at 1bpm
-    const float rate_max = 1.f / ( (beatsPerBar * bars_min) / (bpm_max * minutesPerSecond) ); // 53.3333
-    S1ParameterInfo s1p[S1Parameter::S1ParameterCount] = {
-        { index1,                0, 1, 1, "index1", "Index 1", kAudioUnitParameterUnit_Generic, true, NULL},
-        { index2,                0, 1, 1, "index2", "Index 2", kAudioUnitParameterUnit_Generic, true, NULL},
-        { morphBalance,          0, 0.5, 1, "morphBalance", "morphBalance", kAudioUnitParameterUnit_Generic, true, NULL},
-        { morph1SemitoneOffset,  -12, 0, 24, "morph1SemitoneOffset", "morph1SemitoneOffset", kAudioUnitParameterUnit_RelativeSemiTones, false, NULL},
-        { morph2SemitoneOffset,  -12, 0, 24, "morph2SemitoneOffset", "morph2SemitoneOffset", kAudioUnitParameterUnit_RelativeSemiTones, false, NULL},
-        { morph1Volume,          0, 0.8, 1, "morph1Volume", "morph1Volume", kAudioUnitParameterUnit_Generic, true, NULL},
-        { morph2Volume,          0, 0.8, 1, "morph2Volume", "morph2Volume", kAudioUnitParameterUnit_Generic, true, NULL},
-        { subVolume,             0, 0, 1, "subVolume", "subVolume", kAudioUnitParameterUnit_Generic, true, NULL},
-        { subOctaveDown,         0, 0, 1, "subOctaveDown", "subOctaveDown", kAudioUnitParameterUnit_Generic, false, NULL},
-        { subIsSquare,           0, 0, 1, "subIsSquare", "subIsSquare", kAudioUnitParameterUnit_Generic, false, NULL},
-        { fmVolume,              0, 0, 1, "fmVolume", "fmVolume", kAudioUnitParameterUnit_Generic, true, NULL},
-        { fmAmount,              0, 0, 15, "fmAmount", "fmAmount", kAudioUnitParameterUnit_Generic, true, NULL},
-        { noiseVolume,           0, 0, 0.25, "noiseVolume", "noiseVolume", kAudioUnitParameterUnit_Generic, true, NULL},
-        { lfo1Index,             0, 0, 3, "lfo1Index", "lfo1Index", kAudioUnitParameterUnit_Generic, false, NULL},
-        { lfo1Amplitude,         0, 0, 1, "lfo1Amplitude", "lfo1Amplitude", kAudioUnitParameterUnit_Generic, true, NULL},
-        { lfo1Rate,              rate_min, 0.25, rate_max, "lfo1Rate", "lfo1Rate", kAudioUnitParameterUnit_Rate, false, NULL},
-        { cutoff,                64, 20000, 22050, "cutoff", "cutoff", kAudioUnitParameterUnit_Hertz, true, NULL},
-        { resonance,             0, 0.1, 0.98, "resonance", "resonance", kAudioUnitParameterUnit_Generic, true, NULL},
-        { filterMix,             0, 1, 1, "filterMix", "filterMix", kAudioUnitParameterUnit_Generic, true, NULL},
-        { filterADSRMix,         0, 0, 1.2, "filterADSRMix", "filterADSRMix", kAudioUnitParameterUnit_Generic, true, NULL},
-        { isMono,                0, 0, 1, "isMono", "isMono", kAudioUnitParameterUnit_Generic, false, NULL},
-        { glide,                 0, 0, 0.2, "glide", "glide", kAudioUnitParameterUnit_Generic, true, NULL},
-        { filterAttackDuration,  0.0005, 0.05, 2, "filterAttack", "filterAttackDuration", kAudioUnitParameterUnit_Seconds, true, NULL},
-        { filterDecayDuration,   0.005, 0.05, 2, "filterDecay", "filterDecayDuration", kAudioUnitParameterUnit_Seconds, true, NULL},
-        { filterSustainLevel,    0, 1, 1, "filterSustain", "filterSustainLevel", kAudioUnitParameterUnit_Generic, true, NULL},
-        { filterReleaseDuration, 0, 0.5, 2, "filterRelease", "filterReleaseDuration", kAudioUnitParameterUnit_Seconds, true, NULL},
-        { attackDuration,        0.0005, 0.05, 2, "attackDuration", "attackDuration", kAudioUnitParameterUnit_Seconds, true, NULL},
-        { decayDuration,         0.005, 0.005, 2, "decayDuration", "decayDuration", kAudioUnitParameterUnit_Seconds, true, NULL},
-        { sustainLevel,          0, 0.8, 1, "sustainLevel", "sustainLevel", kAudioUnitParameterUnit_Generic, true, NULL},
-        { releaseDuration,       0.004, 0.05, 2, "releaseDuration", "releaseDuration", kAudioUnitParameterUnit_Seconds, true, NULL},
-        { morph2Detuning,        -4, 0, 4, "morph2Detuning", "morph2Detuning", kAudioUnitParameterUnit_Generic, true, NULL},
-        { detuningMultiplier,    1, 1, 2, "detuningMultiplier", "detuningMultiplier", kAudioUnitParameterUnit_Generic, true, NULL},
-        { masterVolume,          0, 0.5, 2, "masterVolume", "masterVolume", kAudioUnitParameterUnit_Generic, true, NULL},
-        { bitCrushDepth,         1, 24, 24, "bitCrushDepth", "bitCrushDepth", kAudioUnitParameterUnit_Generic, false, NULL},// UNUSED
-        { bitCrushSampleRate,    2048, 48000, 48000, "bitCrushSampleRate", "bitCrushSampleRate", kAudioUnitParameterUnit_Hertz, true, NULL},
-        { autoPanAmount,         0, 0, 1, "autoPanAmount", "autoPanAmount", kAudioUnitParameterUnit_Generic, true, NULL},
-        { autoPanFrequency,      rate_min, 0.25, 10, "autoPanFrequency", "autoPanFrequency", kAudioUnitParameterUnit_Hertz, true, NULL},
-        { reverbOn,              0, 1, 1, "reverbOn", "reverbOn", kAudioUnitParameterUnit_Generic, true, NULL},
-        { reverbFeedback,        0, 0.5, 1, "reverbFeedback", "reverbFeedback", kAudioUnitParameterUnit_Generic, true, NULL},
-        { reverbHighPass,        80, 700, 900, "reverbHighPass", "reverbHighPass", kAudioUnitParameterUnit_Generic, true, NULL},
-        { reverbMix,             0, 0, 1, "reverbMix", "reverbMix", kAudioUnitParameterUnit_Generic, true, NULL},
-        { delayOn,               0, 0, 1, "delayOn", "delayOn", kAudioUnitParameterUnit_Generic, true, NULL},
-        { delayFeedback,         0, 0.1, 0.9, "delayFeedback", "delayFeedback", kAudioUnitParameterUnit_Generic, true, NULL},
-        { delayTime,             0.0003628117914, 0.25, 2.5, "delayTime", "delayTime", kAudioUnitParameterUnit_Seconds, true, NULL},
-        { delayMix,              0, 0.125, 1, "delayMix", "delayMix", kAudioUnitParameterUnit_Generic, true, NULL},
-        { lfo2Index,             0, 0, 3, "lfo2Index", "lfo2Index", kAudioUnitParameterUnit_Generic, false, NULL},
-        { lfo2Amplitude,         0, 0, 1, "lfo2Amplitude", "lfo2Amplitude", kAudioUnitParameterUnit_Generic, true, NULL},
-        { lfo2Rate,              rate_min, 0.25, rate_max, "lfo2Rate", "lfo2Rate", kAudioUnitParameterUnit_Generic, false, NULL},
-        { cutoffLFO,             0, 0, 3, "cutoffLFO", "cutoffLFO", kAudioUnitParameterUnit_Generic, false, NULL},
-        { resonanceLFO,          0, 0, 3, "resonanceLFO", "resonanceLFO", kAudioUnitParameterUnit_Generic, false, NULL},
-        { oscMixLFO,             0, 0, 3, "oscMixLFO", "oscMixLFO", kAudioUnitParameterUnit_Generic, false, NULL},
-        { reverbMixLFO,            0, 0, 3, "reverbMixLFO", "reverbMixLFO", kAudioUnitParameterUnit_Generic, false, NULL},
-        { decayLFO,              0, 0, 3, "decayLFO", "decayLFO", kAudioUnitParameterUnit_Generic, false, NULL},
-        { noiseLFO,              0, 0, 3, "noiseLFO", "noiseLFO", kAudioUnitParameterUnit_Generic, false, NULL},
-        { fmLFO,                 0, 0, 3, "fmLFO", "fmLFO", kAudioUnitParameterUnit_Generic, false, NULL},
-        { detuneLFO,             0, 0, 3, "detuneLFO", "detuneLFO", kAudioUnitParameterUnit_Generic, false, NULL},
-        { filterEnvLFO,          0, 0, 3, "filterEnvLFO", "filterEnvLFO", kAudioUnitParameterUnit_Generic, false, NULL},
-        { pitchLFO,              0, 0, 3, "pitchLFO", "pitchLFO", kAudioUnitParameterUnit_Generic, false, NULL},
-        { bitcrushLFO,           0, 0, 3, "bitcrushLFO", "bitcrushLFO", kAudioUnitParameterUnit_Generic, false, NULL},
-        { tremoloLFO,            0, 0, 3, "tremoloLFO", "tremoloLFO", kAudioUnitParameterUnit_Generic, false, NULL},
-        { arpDirection,          0, 1, 2, "arpDirection", "arpDirection", kAudioUnitParameterUnit_Generic, false, NULL},
-        { arpInterval,           0, 12, 12, "arpInterval", "arpInterval", kAudioUnitParameterUnit_Generic, false, NULL},
-        { arpIsOn,               0, 0, 1, "arpIsOn", "arpIsOn", kAudioUnitParameterUnit_Generic, false, NULL},
-        { arpOctave,             0, 1, 3, "arpOctave", "arpOctave", kAudioUnitParameterUnit_Generic, false, NULL},
-        { arpRate,               bpm_min, 120, bpm_max, "arpRate", "arpRate", kAudioUnitParameterUnit_BPM, false, NULL},
-        { arpIsSequencer,        0, 0, 1, "arpIsSequencer", "arpIsSequencer", kAudioUnitParameterUnit_Generic, false, NULL},
-        { arpTotalSteps,         1, 4, 16, "arpTotalSteps", "arpTotalSteps" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern00,       -12, 0, 12, "sequencerPattern00", "sequencerPattern00" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern01,       -12, 0, 12, "sequencerPattern01", "sequencerPattern01" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern02,       -12, 0, 12, "sequencerPattern02", "sequencerPattern02" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern03,       -12, 0, 12, "sequencerPattern03", "sequencerPattern03" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern04,       -12, 0, 12, "sequencerPattern04", "sequencerPattern04" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern05,       -12, 0, 12, "sequencerPattern05", "sequencerPattern05" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern06,       -12, 0, 12, "sequencerPattern06", "sequencerPattern06" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern07,       -12, 0, 12, "sequencerPattern07", "sequencerPattern07" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern08,       -12, 0, 12, "sequencerPattern08", "sequencerPattern08" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern09,       -12, 0, 12, "sequencerPattern09", "sequencerPattern09" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern10,       -12, 0, 12, "sequencerPattern10", "sequencerPattern10" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern11,       -12, 0, 12, "sequencerPattern11", "sequencerPattern11" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern12,       -12, 0, 12, "sequencerPattern12", "sequencerPattern12" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern13,       -12, 0, 12, "sequencerPattern13", "sequencerPattern13" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern14,       -12, 0, 12, "sequencerPattern14", "sequencerPattern14" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerPattern15,       -12, 0, 12, "sequencerPattern15", "sequencerPattern15" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost00,      0, 0, 1, "sequencerOctBoost00", "sequencerOctBoost00" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost01,      0, 0, 1, "sequencerOctBoost01", "sequencerOctBoost01" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost02,      0, 0, 1, "sequencerOctBoost02", "sequencerOctBoost02" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost03,      0, 0, 1, "sequencerOctBoost03", "sequencerOctBoost03" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost04,      0, 0, 1, "sequencerOctBoost04", "sequencerOctBoost04" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost05,      0, 0, 1, "sequencerOctBoost05", "sequencerOctBoost05" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost06,      0, 0, 1, "sequencerOctBoost06", "sequencerOctBoost06" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost07,      0, 0, 1, "sequencerOctBoost07", "sequencerOctBoost07" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost08,      0, 0, 1, "sequencerOctBoost08", "sequencerOctBoost08" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost09,      0, 0, 1, "sequencerOctBoost09", "sequencerOctBoost09" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost10,      0, 0, 1, "sequencerOctBoost10", "sequencerOctBoost10" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost11,      0, 0, 1, "sequencerOctBoost11", "sequencerOctBoost11" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost12,      0, 0, 1, "sequencerOctBoost12", "sequencerOctBoost12" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost13,      0, 0, 1, "sequencerOctBoost13", "sequencerOctBoost13" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost14,      0, 0, 1, "sequencerOctBoost14", "sequencerOctBoost14" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerOctBoost15,      0, 0, 1, "sequencerOctBoost15", "sequencerOctBoost15" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn00,        0, 0, 1, "sequencerNoteOn00", "sequencerNoteOn00" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn01,        0, 0, 1, "sequencerNoteOn01", "sequencerNoteOn01" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn02,        0, 0, 1, "sequencerNoteOn02", "sequencerNoteOn02" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn03,        0, 0, 1, "sequencerNoteOn03", "sequencerNoteOn03" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn04,        0, 0, 1, "sequencerNoteOn04", "sequencerNoteOn04" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn05,        0, 0, 1, "sequencerNoteOn05", "sequencerNoteOn05" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn06,        0, 0, 1, "sequencerNoteOn06", "sequencerNoteOn06" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn07,        0, 0, 1, "sequencerNoteOn07", "sequencerNoteOn07" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn08,        0, 0, 1, "sequencerNoteOn08", "sequencerNoteOn08" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn09,        0, 0, 1, "sequencerNoteOn09", "sequencerNoteOn09" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn10,        0, 0, 1, "sequencerNoteOn10", "sequencerNoteOn10" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn11,        0, 0, 1, "sequencerNoteOn11", "sequencerNoteOn11" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn12,        0, 0, 1, "sequencerNoteOn12", "sequencerNoteOn12" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn13,        0, 0, 1, "sequencerNoteOn13", "sequencerNoteOn13" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn14,        0, 0, 1, "sequencerNoteOn14", "sequencerNoteOn14" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { sequencerNoteOn15,        0, 0, 1, "sequencerNoteOn15", "sequencerNoteOn15" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { filterType,            0, 0, 2, "filterType", "filterType" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { phaserMix,             0, 0, 1, "phaserMix", "phaserMix" , kAudioUnitParameterUnit_Generic, true, NULL},
-        { phaserRate,            1, 12, 300, "phaserRate", "phaserRate" , kAudioUnitParameterUnit_Hertz, true, NULL},
-        { phaserFeedback,        0, 0.0, 0.8, "phaserFeedback", "phaserFeedback" , kAudioUnitParameterUnit_Generic, true, NULL},
-        { phaserNotchWidth,      100, 800, 1000, "phaserNotchWidth", "phaserNotchWidth" , kAudioUnitParameterUnit_Hertz, true, NULL},
-        { monoIsLegato,          0, 0, 1, "monoIsLegato", "monoIsLegato" , kAudioUnitParameterUnit_Generic, false, NULL},
-        { widen,                 0, 0, 1, "widen", "widen" , kAudioUnitParameterUnit_Generic, true, NULL},//this is a toggle, but we smooth it for crossfade
-        
-        { compressorMasterRatio,      1, 20, 20, "master compressor ratio", "master compressor ratio", kAudioUnitParameterUnit_Generic, false, NULL},
-        { compressorReverbInputRatio, 1, 13, 20, "reverb input compressor ratio", "reverb input compressor ratio", kAudioUnitParameterUnit_Generic, false, NULL},
-        { compressorReverbWetRatio,   1, 13, 20, "reverb wet compressor ratio", "reverb wet compressor ratio", kAudioUnitParameterUnit_Generic, false, NULL},
-        
-        { compressorMasterThreshold,      -60, -9, 0, "master compressor threshold", "master compressor threshold", kAudioUnitParameterUnit_Generic, false, NULL},
-        { compressorReverbInputThreshold, -60, -8.5, 0, "reverb input compressor threshold", "reverb input compressor threshold", kAudioUnitParameterUnit_Generic, false, NULL},
-        { compressorReverbWetThreshold,   -60, -8, 0, "reverb wet compressor threshold", "reverb wet compressor threshold", kAudioUnitParameterUnit_Generic, false, NULL},
-        
-        { compressorMasterAttack,      0, 0.001, 0.01, "master compressor attack", "master compressor attack", kAudioUnitParameterUnit_Generic, false, NULL},
-        { compressorReverbInputAttack, 0, 0.001, 0.01, "reverb input compressor attack", "reverb input compressor attack", kAudioUnitParameterUnit_Generic, false, NULL},
-        { compressorReverbWetAttack,   0, 0.001, 0.01, "reverb wet compressor attack", "reverb wet compressor attack", kAudioUnitParameterUnit_Generic, false, NULL},
-        
-        { compressorMasterRelease,      0, 0.15, 0.5, "master compressor release", "master compressor release", kAudioUnitParameterUnit_Generic, false, NULL},
-        { compressorReverbInputRelease, 0, 0.225, 0.5, "reverb input compressor release", "reverb input compressor release", kAudioUnitParameterUnit_Generic, false, NULL},
-        { compressorReverbWetRelease,   0, 0.15, 0.5, "reverb wet compressor release", "reverb wet compressor release", kAudioUnitParameterUnit_Generic, false, NULL},
-        
-        { compressorMasterMakeupGain, 0.5, 2, 4, "master compressor makeup gain", "master compressor makeup gain", kAudioUnitParameterUnit_Generic, false, NULL},
-        { compressorReverbInputMakeupGain, 0.5, 1.88, 4, "reverb input compressor makeup gain", "reverb input compressor makeup gain", kAudioUnitParameterUnit_Generic, false, NULL},
-        { compressorMasterMakeupGain, 0.5, 1.88, 4, "reverb wet compressor makeup gain", "reverb wet compressor makeup gain", kAudioUnitParameterUnit_Generic, false, NULL},
-        
-        { delayInputCutoffTrackingRatio, 0.5, 0.75, 1, "delayInputCutoffTrackingRatio", "delayInputCutoffTrackingRatio", kAudioUnitParameterUnit_Hertz, false, NULL},
-        { delayInputResonance, 0, 0.0, 0.98, "delayInputResonance", "delayInputResonance", kAudioUnitParameterUnit_Generic, false, NULL},
-        { tempoSyncToArpRate, 0, 1, 1, "tempoSyncToArpRate", "tempoSyncToArpRate", kAudioUnitParameterUnit_Generic, false, NULL},
-        
-        { pitchbend,              0, 8192, 16383, "pitchbend", "pitchbend", kAudioUnitParameterUnit_Generic, false, NULL},
-        { pitchbendMinSemitones,  -24, -12, 0, "pitchbendMinSemitones", "pitchbendMinSemitones", kAudioUnitParameterUnit_Generic, false, NULL},
-        { pitchbendMaxSemitones,  0, 12, 24, "pitchbendMaxSemitones", "pitchbendMaxSemitones", kAudioUnitParameterUnit_Generic, false, NULL},
-        
-        { frequencyA4,  410, 440, 470, "frequencyA4", "frequencyA4", kAudioUnitParameterUnit_Hertz, true, NULL},
-        { portamentoHalfTime, 0.000001, 0.1, 0.99, "portamentoHalfTime", "portamentoHalfTime", kAudioUnitParameterUnit_Generic, true, NULL },
-
-        /* DEPRECATED -1 = no override, else = index into bandlimited wavetable */
-        { oscBandlimitIndexOverride, -1, -1, (S1_NUM_BANDLIMITED_FTABLES-1), "oscBandlimitIndexOverride", "oscBandlimitIndexOverride", kAudioUnitParameterUnit_Generic, false, NULL },
-        { oscBandlimitEnable, 0, 0, 1, "oscBandlimitEnable", "oscBandlimitEnable", kAudioUnitParameterUnit_Generic, false, NULL},
-
-        { arpSeqTempoMultiplier, bars_min, 0.25, bars_max, "arpSeqTempoMultiplier", "arpSeqTempoMultiplier", kAudioUnitParameterUnit_Generic, false, NULL},
-
-        { transpose, -24, 0, 24, "transpose", "transpose", kAudioUnitParameterUnit_Generic, false, NULL},
-
-        { adsrPitchTracking, 0, 0, 1, "adsrPitchTracking", "adsrPitchTracking", kAudioUnitParameterUnit_Generic, true, NULL}
-
-    };
 };
 #endif
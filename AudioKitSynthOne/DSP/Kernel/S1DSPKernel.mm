@@ -5,29 +5,84 @@
 //  Created by AudioKit Contributors on 1/27/18.
 //  Copyright © 2018 AudioKit. All rights reserved.
 //
-#include <functional>
-
 #import <AudioKit/AudioKit-Swift.h>
 #import "../Sequencer/S1ArpModes.hpp"
 #import "S1DSPKernel.hpp"
 #import "AEArray.h"
 #import "S1NoteState.hpp"
 
-using namespace std::placeholders;
-
 S1DSPKernel::S1DSPKernel(int _channels, double _sampleRate) :
-    sequencer(std::bind(std::mem_fn<void(int, int)>(&S1DSPKernel::turnOnKey), this, _1, _2),
-              std::bind(std::mem_fn<void(int)>(&S1DSPKernel::turnOffKey), this, _1),
-              std::bind(std::bind(&S1DSPKernel::beatCounterDidChange, this))),
     AKSoundpipeKernel(_channels, _sampleRate),
     mCompMaster(sp, &parameters),
     mCompReverbWet(sp, &parameters),
     mCompReverbIn(sp, &parameters)
 {
+    // intialize dsp tuning table with 12ET.  Kept across init, the tuning does not depend on the sample rate
+    mMainTuningTable.setEqualTemperament();
+    setTuningTable(mMainTuningTable, false);
+    updateTuningTable();
+
     init(_channels, _sampleRate);
 }
 
-S1DSPKernel::~S1DSPKernel() = default;
+S1DSPKernel::~S1DSPKernel() {
+    if (mIsInitialized) {
+        destroy();
+    }
+    for (sp_ftbl *&table : mOwnedWavetables) {
+        if (table) {
+            sp_ftbl_destroy(&table);
+        }
+    }
+}
+
+// delay and modulation depth, in seconds, of the 8 delay lines of sp_revsc
+static const float kReverbDelayLines[8][2] = {
+    {2473.f / 44100.f, 0.0010f}, {2767.f / 44100.f, 0.0011f}, {3217.f / 44100.f, 0.0017f}, {3557.f / 44100.f, 0.0006f},
+    {3907.f / 44100.f, 0.0010f}, {4127.f / 44100.f, 0.0011f}, {2143.f / 44100.f, 0.0017f}, {1933.f / 44100.f, 0.0006f}
+};
+
+size_t S1DSPKernel::arenaFootprint(int sampleRate) {
+    // the buffers as sp_vdelay_init, sp_delay_init and sp_revsc_init size them; one sample more per reverb delay
+    // line in case float rounding differs
+    const size_t variableDelayBytes = ((size_t)(S1_MAX_DELAY_SECONDS * sampleRate) + 1) * sizeof(SPFLOAT);
+    const size_t widenDelayBytes = (size_t)round(S1_WIDEN_DELAY_SECONDS * sampleRate) * sizeof(SPFLOAT);
+    size_t reverbBytes = 0;
+    for (const float *line : kReverbDelayLines) {
+        reverbBytes += ((size_t)((line[0] + line[1] * 1.125f) * sampleRate + 16.5f) + 1) * sizeof(SPFLOAT);
+    }
+    return S1DSPArena::footprint<sp_port>() * (S1PortamentoParameters::kCount + 1) +
+        S1DSPArena::footprint<sp_osc, sp_pan2, sp_moogladder, sp_moogladder, sp_vdelay, sp_vdelay, sp_vdelay, sp_vdelay,
+            sp_crossfade, sp_crossfade, sp_revsc, sp_buthp, sp_buthp, sp_crossfade, sp_crossfade, sp_delay>() +
+        S1DSPArena::alignedSize(variableDelayBytes) * 4 + S1DSPArena::alignedSize(widenDelayBytes) +
+        S1DSPArena::alignedSize(reverbBytes) +
+        S1DSPArena::footprint<NoteStateArray, S1NoteState>() +
+        S1NoteState::kArenaFootprint * (S1_MAX_POLYPHONY + 1);
+}
+
+void S1DSPKernel::moveToArena(sp_auxdata &aux, void *room) {
+    if (!room) {
+        room = mArena.allocate(aux.size);
+    }
+    if (!room) {
+        printf("S1DSPKernel: no room in the arena for a buffer of %zu bytes\n", aux.size);
+        return;
+    }
+    const size_t size = aux.size;
+    memcpy(room, aux.ptr, size);
+    sp_auxdata_free(&aux);
+    aux.ptr = room;
+    aux.size = size;
+}
+
+void S1DSPKernel::initReverb(void *room) {
+    sp_revsc_init(sp, reverbCostello);
+    const char *buffer = (const char *)reverbCostello->aux.ptr;
+    moveToArena(reverbCostello->aux, room);
+    for (sp_revsc_dl &line : reverbCostello->delayLines) {
+        line.buf = (SPFLOAT *)((char *)reverbCostello->aux.ptr + ((const char *)line.buf - buffer));
+    }
+}
 
 void S1DSPKernel::init(int _channels, double _sampleRate) {
     if (mIsInitialized) {
@@ -36,64 +91,85 @@ void S1DSPKernel::init(int _channels, double _sampleRate) {
     sp->sr = _sampleRate;
     sp->nchan = _channels;
 
-    for(int i = 0; i< S1Parameter::S1ParameterCount; i++) {
-      sp_port_create(&s1p[i].portamento);
+    // the modules of init, the effect buffers, then the note states; initializeNoteStates carves the modules of the
+    // voices after them.  Without the arena the kernel stays uninitialized
+    if (!mArena.reset(arenaFootprint(sp->sr))) {
+        printf("S1DSPKernel::init: could not allocate the %zu byte arena\n", arenaFootprint(sp->sr));
+        return;
+    }
+
+    // voices start at the host rate; process() switches to the oversampling parameter's rate
+    sp_create(&voiceSp);
+    voiceSp->sr = _sampleRate;
+    voiceSp->nchan = 1;
+    oversamplingFactor = 1;
+    oversamplingFrequencyScale = 1.f;
+    oversamplingNoiseGain = 1.f;
+    mOversampler.reset();
+    for (S1PortamentoState& s : portamentoStates) {
+      mArena.create(&s.portamento);
     }
     setupParameterTree(std::nullopt);
 
     //MONO
-    sp_ftbl_create(sp, &sine, S1_FTABLE_SIZE);
-    sp_gen_sine(sp, sine);
-    sp_phasor_create(&lfo1Phasor);
-    sp_phasor_init(sp, lfo1Phasor, 0);
-    sp_phasor_create(&lfo2Phasor);
-    sp_phasor_init(sp, lfo2Phasor, 0);
+    if (mWavetableBank) {
+        if (mWavetableBank->sampleRate() != _sampleRate) {
+            bindWavetableBank(S1WavetableBank::shared(_sampleRate, *mWavetableBank));
+        }
+        sine = mWavetableBank->sine();
+    } else {
+        sp_ftbl_create(sp, &sine, S1_FTABLE_SIZE);
+        sp_gen_sine(sp, sine);
+    }
+    mCompMaster.updateSampleRate();
+    mCompReverbIn.updateSampleRate();
+    mCompReverbWet.updateSampleRate();
+    mLFOBank.init(_sampleRate);
+    modulationMatrix.bind(mLFOBank);
+    mLoadMonitor.init(_sampleRate);
     sp_phaser_create(&phaser0);
     sp_phaser_init(sp, phaser0);
-    sp_port_create(&monoFrequencyPort);
+    mArena.create(&monoFrequencyPort);
     sp_port_init(sp, monoFrequencyPort, 0.05f);
-    sp_port_create(&lfo1Port);
-    static const float kLFOSmoothHalftime = 0.0053125f; // empirical
-    sp_port_init(sp, lfo1Port, kLFOSmoothHalftime);
-    sp_port_create(&lfo2Port);
-    sp_port_init(sp, lfo2Port, kLFOSmoothHalftime);
-    sp_osc_create(&panOscillator);
+    mArena.create(&panOscillator);
     sp_osc_init(sp, panOscillator, sine, 0.f);
-    sp_pan2_create(&pan);
+    mArena.create(&pan);
     sp_pan2_init(sp, pan);
 
     //STEREO
-    sp_moogladder_create(&loPassInputDelayL);
+    mArena.create(&loPassInputDelayL);
     sp_moogladder_init(sp, loPassInputDelayL);
-    sp_moogladder_create(&loPassInputDelayR);
+    mArena.create(&loPassInputDelayR);
     sp_moogladder_init(sp, loPassInputDelayR);
-    sp_vdelay_create(&delayL);
-    sp_vdelay_create(&delayR);
-    sp_vdelay_create(&delayRR);
-    sp_vdelay_create(&delayFillIn);
-    sp_vdelay_init(sp, delayL, 10.f);
-    sp_vdelay_init(sp, delayR, 10.f);
-    sp_vdelay_init(sp, delayRR, 10.f);
-    sp_vdelay_init(sp, delayFillIn, 10.f);
-    sp_crossfade_create(&delayCrossfadeL);
-    sp_crossfade_create(&delayCrossfadeR);
+    mArena.create(&delayL);
+    mArena.create(&delayR);
+    mArena.create(&delayRR);
+    mArena.create(&delayFillIn);
+    for (sp_vdelay *delay : {delayL, delayR, delayRR, delayFillIn}) {
+        sp_vdelay_init(sp, delay, S1_MAX_DELAY_SECONDS);
+        moveToArena(delay->buf);
+    }
+    mArena.create(&delayCrossfadeL);
+    mArena.create(&delayCrossfadeR);
     sp_crossfade_init(sp, delayCrossfadeL);
     sp_crossfade_init(sp, delayCrossfadeR);
-    sp_revsc_create(&reverbCostello);
-    sp_revsc_init(sp, reverbCostello);
-    sp_buthp_create(&butterworthHipassL);
+    mArena.create(&reverbCostello);
+    initReverb();
+    mArena.create(&butterworthHipassL);
     sp_buthp_init(sp, butterworthHipassL);
-    sp_buthp_create(&butterworthHipassR);
+    mArena.create(&butterworthHipassR);
     sp_buthp_init(sp, butterworthHipassR);
-    sp_crossfade_create(&revCrossfadeL);
-    sp_crossfade_create(&revCrossfadeR);
+    mArena.create(&revCrossfadeL);
+    mArena.create(&revCrossfadeR);
     sp_crossfade_init(sp, revCrossfadeL);
     sp_crossfade_init(sp, revCrossfadeR);
-    sp_delay_create(&widenDelay);
-    sp_delay_init(sp, widenDelay, 0.05f);
+    mArena.create(&widenDelay);
+    sp_delay_init(sp, widenDelay, S1_WIDEN_DELAY_SECONDS);
+    moveToArena(widenDelay->buf);
     widenDelay->feedback = 0.f;
-    noteStates = std::make_unique<NoteStateArray>();
-    monoNote = std::make_unique<S1NoteState>();
+    noteStates = mArena.make<NoteStateArray>();
+    monoNote = mArena.make<S1NoteState>();
+    mVoiceArenaMark = mArena.mark();
 
     heldNoteNumbers = (NSMutableArray<NSValue*>*)[NSMutableArray array];
     heldNoteNumbersAE = [[AEArray alloc] initWithCustomMapping:^void *(id item) {
@@ -108,24 +184,21 @@ void S1DSPKernel::init(int _channels, double _sampleRate) {
 
     _rate.init();
 
-    // intialize dsp tuning table with 12ET
-    for(int i = 0; i < 128; i++) {
-        tuningTable[i].store(440. * exp2((i - 69)/12.));
-    }
-
     // restore values
+    resetRenderState();
     restoreValues(std::nullopt);
     mIsInitialized = true;
+    setRandomSeed(mRandomSeed);
 }
 
 void S1DSPKernel::setupParameterTree(std::optional<DSPParameters> params) {
     // copy dsp values or initialize with default
     for(int i = 0; i< S1Parameter::S1ParameterCount; i++) {
         const float value = (params != std::nullopt) ? (*params)[i] : defaultValue((S1Parameter)i);
-        if (s1p[i].usePortamento) {
-            s1p[i].portamentoTarget = value;
-            sp_port_init(sp, s1p[i].portamento, value);
-            s1p[i].portamento->htime = S1_PORTAMENTO_HALF_TIME;
+        if (S1PortamentoState *s = portamentoState((S1Parameter)i)) {
+            s->portamentoTarget = value;
+            sp_port_init(sp, s->portamento, value);
+            s->portamento->htime = S1_PORTAMENTO_HALF_TIME;
         }
         parameters[i] = value;
     }
@@ -142,6 +215,7 @@ void S1DSPKernel::restoreValues(std::optional<DSPParameters> params) {
     _arpSeqTempoMultiplier = {S1Parameter::arpSeqTempoMultiplier, getDependentParameter(arpSeqTempoMultiplier), getSynthParameter(arpSeqTempoMultiplier),0};
 
     previousProcessMonoPolyStatus = parameters[isMono];
+    mModeCrossfadeFramesRemaining = 0;
     *phaser0->MinNotch1Freq = 100;
     *phaser0->MaxNotch1Freq = 800;
     *phaser0->Notch_width = 1000;
@@ -161,32 +235,10 @@ void S1DSPKernel::restoreValues(std::optional<DSPParameters> params) {
     sequencer.init();
 
     initializedNoteStates = false;
-    aePlayingNotes.polyphony = S1_MAX_POLYPHONY;
 
     // initializeNoteStates() must be called AFTER init returns, BEFORE process, turnOnKey, and turnOffKey
 }
 
 
-// private tuningTable lookup
-double S1DSPKernel::tuningTableNoteToHz(int noteNumber) {
-    const int nn = clamp(noteNumber, 0, 127);
-    return getTuningTableFrequency(nn);
-}
-
-// S1TuningTable protocol
-void S1DSPKernel::setTuningTable(float frequency, int index) {
-    const int i = clamp(index, 0, 127);
-    tuningTable[i].store(frequency);
-}
-
-float S1DSPKernel::getTuningTableFrequency(int index) {
-    const int i = clamp(index, 0, 127);
-    return tuningTable[i].load();
-}
-
-void S1DSPKernel::setTuningTableNPO(int npo) {
-    tuningTableNPO.store(npo);
-    sequencer.setNotesPerOctave(npo);
-}
 
 
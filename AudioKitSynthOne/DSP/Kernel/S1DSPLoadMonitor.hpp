@@ -0,0 +1,156 @@
+//
+//  S1DSPLoadMonitor.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Render cycle timing: host ticks per cycle, and per stage accumulated over the frames of a cycle, published
+//  once per cycle as an S1DSPLoad.  Nothing here allocates, locks or waits.
+//  Stage marks read the clock several times a frame, which costs time and adds it to the stages they measure, so
+//  the stages are timed in one cycle in kStageTimingInterval; the marks of the other cycles only test a flag.
+
+#pragma once
+
+#import <algorithm>
+#import <array>
+#import <atomic>
+#import <cmath>
+#import <mach/mach_time.h>
+#import "S1AudioUnit.h"
+#import "S1TripleBuffer.hpp"
+
+#ifdef __cplusplus
+
+class S1DSPLoadMonitor {
+
+public:
+
+    enum Stage : int {
+        setup = 0,
+        modulation,
+        sequencer,
+        voices,
+        effects,
+        stageCount
+    };
+
+    using Ticks = uint64_t;
+
+    // render cycles per cycle whose stages are timed
+    static constexpr int kStageTimingInterval = 16;
+
+    S1DSPLoadMonitor(const S1DSPLoadMonitor&) = delete;
+
+    S1DSPLoadMonitor() = default;
+
+    // MAIN THREAD: before the first render cycle, and when the sample rate changes
+    void init(double sampleRate) {
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info(&timebase);
+        mSecondsPerTick = (double)timebase.numer / (double)timebase.denom * 1.0e-9;
+        mSampleRate = sampleRate;
+    }
+
+    // ANY THREAD: restart the totals and peaks at the next cycle
+    void reset() {
+        mResetRequested.store(true, std::memory_order_relaxed);
+    }
+
+    // RENDER THREAD
+    inline Ticks now() const {
+        return mach_absolute_time();
+    }
+
+    // start of the first stage of a cycle; 0 if this cycle's stages are not timed
+    inline Ticks stageStart() const {
+        return mTimingStages ? now() : 0;
+    }
+
+    inline void beginCycle() {
+        mTimingStages = mCyclesUntilStageTiming == 0;
+        if (mTimingStages) {
+            mStageTicks.fill(0);
+            mCyclesUntilStageTiming = kStageTimingInterval;
+        }
+        mCyclesUntilStageTiming--;
+        mCycleStart = now();
+    }
+
+    // add the time since `since` to stage; returns the current time, the start of the next stage.
+    // Returns since if this cycle's stages are not timed
+    inline Ticks mark(Stage stage, Ticks since) {
+        if (!mTimingStages) {
+            return since;
+        }
+        const Ticks t = now();
+        mStageTicks[stage] += t - since;
+        return t;
+    }
+
+    void endCycle(uint32_t frameCount, int activeVoices) {
+        const double seconds = (now() - mCycleStart) * mSecondsPerTick;
+        if (mResetRequested.exchange(false, std::memory_order_relaxed)) {
+            mLoad = S1DSPLoad {};
+
+            // time the stages of the next cycle rather than report 0 for up to kStageTimingInterval cycles
+            mCyclesUntilStageTiming = 0;
+        }
+        const double budget = frameCount / mSampleRate;
+        const double load = budget > 0. ? seconds / budget : 0.;
+
+        mLoad.cycleCount++;
+        if (seconds > budget) {
+            mLoad.overBudgetCount++;
+        }
+        mLoad.budgetSeconds = budget;
+        mLoad.cycleSeconds = seconds;
+        mLoad.peakCycleSeconds = std::max(mLoad.peakCycleSeconds, seconds);
+        mLoad.load = load;
+        mLoad.peakLoad = std::max(mLoad.peakLoad, load);
+        if (mLoad.cycleCount == 1) {
+            mLoad.averageLoad = load;
+        } else {
+            mLoad.averageLoad += (1. - exp(-budget / kAveragingSeconds)) * (load - mLoad.averageLoad);
+        }
+        if (mTimingStages) {
+            mLoad.setupSeconds = mStageTicks[setup] * mSecondsPerTick;
+            mLoad.modulationSeconds = mStageTicks[modulation] * mSecondsPerTick;
+            mLoad.sequencerSeconds = mStageTicks[sequencer] * mSecondsPerTick;
+            mLoad.voicesSeconds = mStageTicks[voices] * mSecondsPerTick;
+            mLoad.effectsSeconds = mStageTicks[effects] * mSecondsPerTick;
+        }
+        mLoad.activeVoices = activeVoices;
+        mLoad.peakActiveVoices = std::max(mLoad.peakActiveVoices, activeVoices);
+
+        mLoads.back() = mLoad;
+        mLoads.publish();
+    }
+
+    // MAIN THREAD: latest published load.  Returns false if nothing was published since the last call
+    bool read(S1DSPLoad &load) {
+        if (!mLoads.update()) {
+            return false;
+        }
+        load = mLoads.front();
+        return true;
+    }
+
+private:
+
+    static constexpr double kAveragingSeconds = 1.;
+
+    double mSecondsPerTick = 0.;
+    double mSampleRate = 44100.;
+    Ticks mCycleStart = 0;
+    std::array<Ticks, stageCount> mStageTicks {};
+    bool mTimingStages = false;
+    int mCyclesUntilStageTiming = 0;
+
+    // render thread totals; mLoads holds the buffers shared with the main thread
+    S1DSPLoad mLoad {};
+    S1TripleBuffer<S1DSPLoad> mLoads;
+    std::atomic<bool> mResetRequested {false};
+};
+
+#endif
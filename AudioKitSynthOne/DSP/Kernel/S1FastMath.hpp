@@ -0,0 +1,86 @@
+//
+//  S1FastMath.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Branch-free approximations of the transcendental functions used in the render loop.
+//  Polynomial coefficients are minimax fits; results are within a few float ulps of libm.
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Set S1_FASTMATH_USE_LIBM=1 in the preprocessor macros to render with libm for reference testing
+#ifndef S1_FASTMATH_USE_LIBM
+#define S1_FASTMATH_USE_LIBM 0
+#endif
+
+#ifdef __cplusplus
+
+struct S1FastMath {
+    S1FastMath() = delete;
+
+#if S1_FASTMATH_USE_LIBM
+
+    static inline float exp2(float x) { return exp2f(x); }
+    static inline float log2(float x) { return log2f(x); }
+    static inline float sin2pi(float phase) { return sinf(phase * 2.f * (float)M_PI); }
+
+#else
+
+    // 2^x for x on [-126, 126]
+    static inline float exp2(float x) {
+        x = fminf(fmaxf(x, -126.f), 126.f);
+        const float xi = floorf(x);
+        const float f = x - xi;
+        const float p = 9.999998931e-01f + f * (6.931547525e-01f + f * (2.401397111e-01f +
+                        f * (5.586624631e-02f + f * (8.942828982e-03f + f * 1.896461146e-03f))));
+        const int32_t bits = ((int32_t)xi + 127) << 23;
+        float scale;
+        std::memcpy(&scale, &bits, sizeof(scale));
+        return p * scale;
+    }
+
+    // log2(x) for normal x > 0
+    static inline float log2(float x) {
+        int32_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        float e = (float)(((bits >> 23) & 0xff) - 127);
+        bits = (bits & 0x007fffff) | 0x3f800000;
+        float m;
+        std::memcpy(&m, &bits, sizeof(m));
+
+        // center the mantissa on [sqrt(1/2), sqrt(2))
+        const bool upper = m > (float)M_SQRT2;
+        m = upper ? 0.5f * m : m;
+        e = upper ? e + 1.f : e;
+
+        const float t = m - 1.f;
+        const float p = 1.442694922e+00f + t * (-7.213524874e-01f + t * (4.809311622e-01f + t * (-3.602634619e-01f +
+                        t * (2.868688762e-01f + t * (-2.483228119e-01f + t * (2.357096361e-01f + t * -1.497332625e-01f))))));
+        return e + t * p;
+    }
+
+    // sin(2 * pi * phase) for any phase, i.e., the output of a [0,1] phasor
+    static inline float sin2pi(float phase) {
+        float p = phase - floorf(phase + 0.5f); // [-0.5, 0.5)
+        p = (p > 0.25f) ? 0.5f - p : p;          // fold onto [-0.25, 0.25]
+        p = (p < -0.25f) ? -0.5f - p : p;
+        const float u = p * p;
+        return p * (6.283185280e+00f + u * (-4.134168072e+01f + u * (8.160248511e+01f +
+                    u * (-7.658139642e+01f + u * 3.976161707e+01f))));
+    }
+
+#endif
+
+    // 2^(semitones/12): frequency ratio of a relative note number
+    static inline float nnToHz(float noteNumber) {
+        return exp2(noteNumber / 12.f);
+    }
+};
+
+#endif
@@ -0,0 +1,135 @@
+//
+//  S1LFOBank.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  LFO1, LFO2 and their combination LFO3, rendered a control block at a time.
+//  Each pass is a straight loop over the block so the compiler can vectorize it;
+//  only the one-pole smoothing is a recurrence.
+
+#pragma once
+
+#import <array>
+#import <cmath>
+#import "S1Parameter.h"
+#import "S1FastMath.hpp"
+
+#ifdef __cplusplus
+
+using DSPParameters = std::array<float, S1Parameter::S1ParameterCount>;
+
+#define S1_LFO_BLOCK_SIZE (32)
+
+class S1LFOBank {
+
+public:
+
+    // LFO1, LFO2, LFO3 (the average of LFO1 and LFO2)
+    static constexpr int kLFOCount = 3;
+
+    using Block = std::array<float, S1_LFO_BLOCK_SIZE>;
+
+    void init(double sampleRate) {
+        mOneOverSampleRate = 1.f / (float)sampleRate;
+
+        // one-pole smoothing of discontinuous waveforms, same response as sp_port with a 5.3ms halftime
+        static const float kLFOSmoothHalftime = 0.0053125f; // empirical
+        mSmoothingCoefficient = powf(0.5f, mOneOverSampleRate / kLFOSmoothHalftime);
+        reset();
+    }
+
+    void reset() {
+        mPhase.fill(0.f);
+        mSmooth.fill(0.f);
+    }
+
+    // render frameCount <= S1_LFO_BLOCK_SIZE frames of every LFO.
+    // Rate, waveform and amplitude are sampled once per block.
+    void render(int frameCount, const DSPParameters &parameters) {
+        renderLFO(0, frameCount, parameters[lfo1Rate], (int)parameters[lfo1Index], parameters[lfo1Amplitude]);
+        renderLFO(1, frameCount, parameters[lfo2Rate], (int)parameters[lfo2Index], parameters[lfo2Amplitude]);
+
+        // LFO3: combination of LFO1 and LFO2
+        for (int i = 0; i < frameCount; i++) {
+            mUnipolar[2][i] = 0.5f * (mUnipolar[0][i] + mUnipolar[1][i]);
+            mInverted[2][i] = 0.5f * (mInverted[0][i] + mInverted[1][i]);
+        }
+    }
+
+    // on [0, amplitude]
+    inline const float *unipolar(int lfoIndex) const {
+        return mUnipolar[lfoIndex].data();
+    }
+
+    // on [1 - amplitude, 1]
+    inline const float *inverted(int lfoIndex) const {
+        return mInverted[lfoIndex].data();
+    }
+
+private:
+
+    void renderLFO(int lfoIndex, int frameCount, float rate, int waveform, float amplitude) {
+        Block &out = mScratch;
+
+        // phasor on [0,1)
+        const float increment = rate * mOneOverSampleRate;
+        const float phase0 = mPhase[lfoIndex];
+        for (int i = 0; i < frameCount; i++) {
+            const float phase = phase0 + (float)i * increment;
+            out[i] = phase - floorf(phase);
+        }
+        const float nextPhase = phase0 + (float)frameCount * increment;
+        mPhase[lfoIndex] = nextPhase - floorf(nextPhase);
+
+        // waveform on [-1, 1]
+        switch (waveform) {
+            case 0: // Sine
+                for (int i = 0; i < frameCount; i++)
+                    out[i] = S1FastMath::sin2pi(out[i]);
+                break;
+            case 1: // Square
+                for (int i = 0; i < frameCount; i++)
+                    out[i] = out[i] > 0.5f ? 1.f : -1.f;
+                break;
+            case 2: // Saw
+                for (int i = 0; i < frameCount; i++)
+                    out[i] = (out[i] - 0.5f) * 2.f;
+                break;
+            case 3: // Reversed Saw
+                for (int i = 0; i < frameCount; i++)
+                    out[i] = (0.5f - out[i]) * 2.f;
+                break;
+            default:
+                break;
+        }
+
+        // smooth (for discontinous square, saw, reversed saw)
+        const float c2 = mSmoothingCoefficient;
+        const float c1 = 1.f - c2;
+        float smooth = mSmooth[lfoIndex];
+        for (int i = 0; i < frameCount; i++) {
+            smooth = c1 * out[i] + c2 * smooth;
+            out[i] = smooth;
+        }
+        mSmooth[lfoIndex] = smooth;
+
+        Block &unipolar = mUnipolar[lfoIndex];
+        Block &inverted = mInverted[lfoIndex];
+        for (int i = 0; i < frameCount; i++) {
+            unipolar[i] = 0.5f * (1.f + out[i]) * amplitude;
+            inverted[i] = 1.f - (0.5f * (1.f - out[i]) * amplitude);
+        }
+    }
+
+    float mOneOverSampleRate = 1.f / 44100.f;
+    float mSmoothingCoefficient = 0.f;
+    std::array<float, 2> mPhase {{0.f, 0.f}};
+    std::array<float, 2> mSmooth {{0.f, 0.f}};
+    alignas(16) Block mScratch {};
+    alignas(16) std::array<Block, kLFOCount> mUnipolar {};
+    alignas(16) std::array<Block, kLFOCount> mInverted {};
+};
+
+#endif
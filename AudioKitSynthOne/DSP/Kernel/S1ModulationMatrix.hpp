@@ -0,0 +1,133 @@
+//
+//  S1ModulationMatrix.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  LFO routing resolved to a source block per destination.  Routes are recompiled only when a
+//  routing parameter changes; reading a destination in the render loop is a table lookup.
+
+#pragma once
+
+#import <array>
+#import "S1Parameter.h"
+#import "S1LFOBank.hpp"
+
+#ifdef __cplusplus
+
+// Modulation destinations, one per "*LFO" routing parameter
+enum struct S1ModulationDestination : int {
+    Cutoff = 0,
+    Resonance,
+    OscMix,
+    ReverbMix,
+    Decay,
+    Noise,
+    FM,
+    Detune,
+    FilterEnv,
+    Pitch,
+    Bitcrush,
+    Tremolo,
+    Count
+};
+
+class S1ModulationMatrix {
+
+public:
+
+    static constexpr int kLFOCount = S1LFOBank::kLFOCount;
+
+    S1ModulationMatrix(const S1ModulationMatrix&) = delete;
+
+    S1ModulationMatrix() {
+        mZero.fill(0.f);
+        mOne.fill(1.f);
+        mSources.fill(mZero.data());
+        mSources[kSourceOne] = mOne.data();
+        mRoutingValues.fill(-1.f);
+        mRoutes.fill(kSourceZero);
+    }
+
+    // sources read the block buffers of lfoBank, which must outlive the matrix
+    void bind(const S1LFOBank &lfoBank) {
+        for (int i = 0; i < kLFOCount; i++) {
+            mSources[kSourceLFO_0_1 + i] = lfoBank.unipolar(i);
+            mSources[kSourceLFO_1_0 + i] = lfoBank.inverted(i);
+        }
+    }
+
+    // recompile the routes if any routing parameter changed; call at a buffer boundary
+    void update(const DSPParameters &parameters) {
+        bool changed = false;
+        for (int d = 0; d < kDestinationCount; d++) {
+            const float value = parameters[kDestinations[d].parameter];
+            if (value != mRoutingValues[d]) {
+                mRoutingValues[d] = value;
+                changed = true;
+            }
+        }
+        if (changed) {
+            compile();
+        }
+    }
+
+    // frame lfoFrameIndex of the current LFO block.
+    // Additive destinations read 0 when unrouted, multiplicative destinations read 1
+    inline float value(S1ModulationDestination destination, int lfoFrameIndex) const {
+        return mSources[mRoutes[(int)destination]][lfoFrameIndex];
+    }
+
+private:
+
+    enum Source : int {
+        kSourceZero = 0,
+        kSourceOne = 1,
+        kSourceLFO_0_1 = 2,
+        kSourceLFO_1_0 = kSourceLFO_0_1 + kLFOCount,
+        kSourceCount = kSourceLFO_1_0 + kLFOCount
+    };
+
+    struct DestinationInfo {
+        S1Parameter parameter;
+        Source lfoSource;
+        Source unroutedSource;
+    };
+
+    static constexpr int kDestinationCount = (int)S1ModulationDestination::Count;
+
+    // same order as S1ModulationDestination.  Detune scales morph2Detuning by 1 when unrouted.
+    static constexpr std::array<DestinationInfo, kDestinationCount> kDestinations = {{
+        { cutoffLFO,    kSourceLFO_1_0, kSourceOne },
+        { resonanceLFO, kSourceLFO_1_0, kSourceOne },
+        { oscMixLFO,    kSourceLFO_0_1, kSourceZero },
+        { reverbMixLFO, kSourceLFO_1_0, kSourceOne },
+        { decayLFO,     kSourceLFO_1_0, kSourceOne },
+        { noiseLFO,     kSourceLFO_1_0, kSourceOne },
+        { fmLFO,        kSourceLFO_1_0, kSourceOne },
+        { detuneLFO,    kSourceLFO_0_1, kSourceOne },
+        { filterEnvLFO, kSourceLFO_1_0, kSourceOne },
+        { pitchLFO,     kSourceLFO_0_1, kSourceZero },
+        { bitcrushLFO,  kSourceLFO_0_1, kSourceZero },
+        { tremoloLFO,   kSourceLFO_1_0, kSourceOne }
+    }};
+
+    // routing parameter value 1, 2, 3 selects LFO1, LFO2, LFO3; anything else is unrouted
+    void compile() {
+        for (int d = 0; d < kDestinationCount; d++) {
+            const DestinationInfo &info = kDestinations[d];
+            const int lfo = (int)mRoutingValues[d];
+            const bool routed = (float)lfo == mRoutingValues[d] && lfo >= 1 && lfo <= kLFOCount;
+            mRoutes[d] = routed ? info.lfoSource + lfo - 1 : info.unroutedSource;
+        }
+    }
+
+    S1LFOBank::Block mZero;
+    S1LFOBank::Block mOne;
+    std::array<const float *, kSourceCount> mSources;
+    std::array<float, kDestinationCount> mRoutingValues;
+    std::array<int, kDestinationCount> mRoutes;
+};
+
+#endif
@@ -0,0 +1,131 @@
+//
+//  S1Oversampler.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Polyphase half-band decimation from the oversampled voice rate back to the host rate
+
+#pragma once
+
+#include <array>
+
+#ifdef __cplusplus
+
+#define S1_MAX_OVERSAMPLING (4)
+
+// Quality tiers of S1Parameter::oversampling
+enum struct S1OversamplingMode : int {
+    Economy = 0,  // 1x, voices render at host rate
+    Standard = 1, // 2x
+    High = 2      // 4x
+};
+
+// 2:1 decimator for a Kaiser-windowed half-band FIR of 4 * NumCoefficients - 1 taps.
+// Every other tap of a half-band filter is zero and the center tap is 0.5, so the odd input phase
+// reduces to a pure delay and the even phase is a symmetric FIR with NumCoefficients unique coefficients.
+template<int NumCoefficients>
+class S1HalfbandDecimator {
+
+public:
+
+    S1HalfbandDecimator(const std::array<float, NumCoefficients> &coefficients) : mCoefficients(coefficients) {
+        reset();
+    }
+
+    void reset() {
+        mEven.fill(0.f);
+        mOdd.fill(0.f);
+        mEvenIndex = 0;
+        mOddIndex = 0;
+    }
+
+    // consumes two consecutive input samples, returns one output sample
+    inline float process(float x0, float x1) {
+
+        // even phase: doubled ring so the taps are contiguous; e[j] is the even sample j steps ago
+        mEvenIndex = (mEvenIndex == 0 ? kEvenLength : mEvenIndex) - 1;
+        mEven[mEvenIndex] = mEven[mEvenIndex + kEvenLength] = x1;
+        const float *e = &mEven[mEvenIndex];
+        float out = 0.f;
+        for (int k = 0; k < NumCoefficients; k++) {
+            out += mCoefficients[k] * (e[NumCoefficients - 1 - k] + e[NumCoefficients + k]);
+        }
+
+        // odd phase: center tap
+        const float center = mOdd[mOddIndex];
+        mOdd[mOddIndex] = x0;
+        if (++mOddIndex == kOddLength) mOddIndex = 0;
+
+        return out + 0.5f * center;
+    }
+
+private:
+
+    static constexpr int kEvenLength = 2 * NumCoefficients;
+    static constexpr int kOddLength = NumCoefficients - 1;
+
+    const std::array<float, NumCoefficients> mCoefficients;
+    std::array<float, 2 * kEvenLength> mEven;
+    std::array<float, kOddLength> mOdd;
+    int mEvenIndex = 0;
+    int mOddIndex = 0;
+};
+
+// Decimates a block of 1, 2 or 4 oversampled voice samples to one host-rate sample.
+// Passband is flat to 19kHz and the stopband is below -79dB for a 44.1kHz host rate.
+class S1Oversampler {
+
+public:
+
+    S1Oversampler() : mStage2x(kCoefficients2x), mStage4x(kCoefficients4x) {}
+
+    static inline int factorForMode(S1OversamplingMode mode) {
+        switch(mode) {
+            case S1OversamplingMode::Standard: return 2;
+            case S1OversamplingMode::High:     return 4;
+            default:                           return 1;
+        }
+    }
+
+    void reset() {
+        mStage2x.reset();
+        mStage4x.reset();
+    }
+
+    // input contains "factor" samples at factor * host rate
+    inline float decimate(const float *input, int factor) {
+        switch(factor) {
+            case 2:
+                return mStage2x.process(input[0], input[1]);
+            case 4: {
+                const float x0 = mStage4x.process(input[0], input[1]);
+                const float x1 = mStage4x.process(input[2], input[3]);
+                return mStage2x.process(x0, x1);
+            }
+            default:
+                return input[0];
+        }
+    }
+
+private:
+
+    // 75 taps: 2x rate to host rate. Transition band is 19kHz...25.1kHz at 44.1kHz.
+    static constexpr std::array<float, 19> kCoefficients2x = {
+        3.174552050e-01f, -1.035697580e-01f, 5.951839339e-02f, -3.983171875e-02f, 2.837830253e-02f,
+        -2.077750284e-02f, 1.535323747e-02f, -1.132441246e-02f, 8.272943913e-03f, -5.948425623e-03f,
+        4.185327804e-03f, -2.864418024e-03f, 1.893707112e-03f, -1.198759257e-03f, 7.177291359e-04f,
+        -3.988229311e-04f, 1.989628367e-04f, -8.298357615e-05f, 2.299229517e-05f
+    };
+
+    // 19 taps: 4x rate to 2x rate. Only has to reject what would fold into the final passband.
+    static constexpr std::array<float, 5> kCoefficients4x = {
+        3.041983391e-01f, -6.980526825e-02f, 1.864659954e-02f, -3.134203086e-03f, 9.453273170e-05f
+    };
+
+    S1HalfbandDecimator<19> mStage2x;
+    S1HalfbandDecimator<5> mStage4x;
+};
+
+#endif
@@ -0,0 +1,96 @@
+//
+//  S1ParameterEventQueue.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Bounded lock-free queue of parameter changes from any thread (UI, MIDI, AU parameter observer)
+//  to the render thread, which drains it at the start of every buffer.
+
+#pragma once
+
+#import <array>
+#import <atomic>
+#import <cstdint>
+#import <AudioToolbox/AudioToolbox.h>
+#import "S1Parameter.h"
+
+#ifdef __cplusplus
+
+typedef struct S1ParameterEvent {
+    S1Parameter parameter;
+    float value;
+    AUEventSampleTime sampleTime;   // AUEventSampleTimeImmediate: start of the next buffer
+    AUAudioFrameCount rampDuration; // 0: jump to value
+    uint32_t serial;                // posting order, to discard the events a later preset replaces
+} S1ParameterEvent;
+
+// Multiple producers, single consumer.  Each cell carries a sequence number so producers
+// claim a slot with one compare-and-swap and the consumer never waits on a producer.
+template<typename T, uint32_t Capacity>
+class S1MPSCQueue {
+
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+
+    S1MPSCQueue() {
+        for (uint32_t i = 0; i < Capacity; i++) {
+            mCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    S1MPSCQueue(const S1MPSCQueue&) = delete;
+
+    // ANY THREAD: returns false if the queue is full
+    bool push(const T &item) {
+        uint32_t position = mEnqueuePosition.load(std::memory_order_relaxed);
+        Cell *cell;
+        for (;;) {
+            cell = &mCells[position & kMask];
+            const uint32_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const int32_t difference = (int32_t)(sequence - position);
+            if (difference == 0) {
+                if (mEnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = mEnqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        cell->item = item;
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // CONSUMER THREAD: returns false if the queue is empty
+    bool pop(T &item) {
+        Cell &cell = mCells[mDequeuePosition & kMask];
+        const uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if ((int32_t)(sequence - (mDequeuePosition + 1)) < 0)
+            return false;
+        item = cell.item;
+        cell.sequence.store(mDequeuePosition + Capacity, std::memory_order_release);
+        mDequeuePosition++;
+        return true;
+    }
+
+private:
+
+    static constexpr uint32_t kMask = Capacity - 1;
+
+    struct Cell {
+        std::atomic<uint32_t> sequence;
+        T item;
+    };
+
+    std::array<Cell, Capacity> mCells;
+    alignas(64) std::atomic<uint32_t> mEnqueuePosition {0};
+    alignas(64) uint32_t mDequeuePosition = 0;
+};
+
+using S1ParameterEventQueue = S1MPSCQueue<S1ParameterEvent, 1024>;
+
+#endif
@@ -0,0 +1,261 @@
+//
+//  S1ParameterTable.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Immutable metadata of every S1Parameter, shared by all kernel instances.  A kernel only keeps
+//  the smoothing state of the parameters that use portamento.
+
+#pragma once
+
+#import <array>
+#import <AudioToolbox/AudioToolbox.h>
+#import "S1AudioUnit.h"
+#import "S1Parameter.h"
+
+#ifdef __cplusplus
+
+struct S1ParameterInfo {
+    S1Parameter parameter;
+    float minimum;
+    float defaultValue;
+    float maximum;
+    const char *presetKey;
+    const char *friendlyName;
+    AudioUnitParameterUnit unit;
+    bool usePortamento;
+};
+
+struct S1ParameterTable {
+
+    static constexpr int kCount = S1Parameter::S1ParameterCount;
+
+    // These expressions come from Rate.swift which is used for beat sync
+    static constexpr float minutesPerSecond = 1.f / 60.f;
+    static constexpr float beatsPerBar = 4.f;
+    static constexpr float bpm_min = 1.f;
+    static constexpr float bpm_max = 200.f;
+    static constexpr float bars_min = 1.f / 64.f / 1.5f;
+    static constexpr float bars_max = 8.f;
+    static constexpr float rate_min = 1.f / ( (beatsPerBar * bars_max) / (bpm_min * minutesPerSecond) ); //  0.00052 8 bars at 1bpm
+    static constexpr float rate_max = 1.f / ( (beatsPerBar * bars_min) / (bpm_max * minutesPerSecond) ); // 53.3333
+
+    // indexed by S1Parameter
+    static constexpr std::array<S1ParameterInfo, kCount> kInfo = {{
+        { index1,                0, 1, 1, "index1", "Index 1", kAudioUnitParameterUnit_Generic, true},
+        { index2,                0, 1, 1, "index2", "Index 2", kAudioUnitParameterUnit_Generic, true},
+        { morphBalance,          0, 0.5, 1, "morphBalance", "morphBalance", kAudioUnitParameterUnit_Generic, true},
+        { morph1SemitoneOffset,  -12, 0, 24, "morph1SemitoneOffset", "morph1SemitoneOffset", kAudioUnitParameterUnit_RelativeSemiTones, false},
+        { morph2SemitoneOffset,  -12, 0, 24, "morph2SemitoneOffset", "morph2SemitoneOffset", kAudioUnitParameterUnit_RelativeSemiTones, false},
+        { morph1Volume,          0, 0.8, 1, "morph1Volume", "morph1Volume", kAudioUnitParameterUnit_Generic, true},
+        { morph2Volume,          0, 0.8, 1, "morph2Volume", "morph2Volume", kAudioUnitParameterUnit_Generic, true},
+        { subVolume,             0, 0, 1, "subVolume", "subVolume", kAudioUnitParameterUnit_Generic, true},
+        { subOctaveDown,         0, 0, 1, "subOctaveDown", "subOctaveDown", kAudioUnitParameterUnit_Generic, false},
+        { subIsSquare,           0, 0, 1, "subIsSquare", "subIsSquare", kAudioUnitParameterUnit_Generic, false},
+        { fmVolume,              0, 0, 1, "fmVolume", "fmVolume", kAudioUnitParameterUnit_Generic, true},
+        { fmAmount,              0, 0, 15, "fmAmount", "fmAmount", kAudioUnitParameterUnit_Generic, true},
+        { noiseVolume,           0, 0, 0.25, "noiseVolume", "noiseVolume", kAudioUnitParameterUnit_Generic, true},
+        { lfo1Index,             0, 0, 3, "lfo1Index", "lfo1Index", kAudioUnitParameterUnit_Generic, false},
+        { lfo1Amplitude,         0, 0, 1, "lfo1Amplitude", "lfo1Amplitude", kAudioUnitParameterUnit_Generic, true},
+        { lfo1Rate,              rate_min, 0.25, rate_max, "lfo1Rate", "lfo1Rate", kAudioUnitParameterUnit_Rate, false},
+        { cutoff,                64, 20000, 22050, "cutoff", "cutoff", kAudioUnitParameterUnit_Hertz, true},
+        { resonance,             0, 0.1, 0.98, "resonance", "resonance", kAudioUnitParameterUnit_Generic, true},
+        { filterMix,             0, 1, 1, "filterMix", "filterMix", kAudioUnitParameterUnit_Generic, true},
+        { filterADSRMix,         0, 0, 1.2, "filterADSRMix", "filterADSRMix", kAudioUnitParameterUnit_Generic, true},
+        { isMono,                0, 0, 1, "isMono", "isMono", kAudioUnitParameterUnit_Generic, false},
+        { glide,                 0, 0, 0.2, "glide", "glide", kAudioUnitParameterUnit_Generic, true},
+        { filterAttackDuration,  0.0005, 0.05, 2, "filterAttack", "filterAttackDuration", kAudioUnitParameterUnit_Seconds, true},
+        { filterDecayDuration,   0.005, 0.05, 2, "filterDecay", "filterDecayDuration", kAudioUnitParameterUnit_Seconds, true},
+        { filterSustainLevel,    0, 1, 1, "filterSustain", "filterSustainLevel", kAudioUnitParameterUnit_Generic, true},
+        { filterReleaseDuration, 0, 0.5, 2, "filterRelease", "filterReleaseDuration", kAudioUnitParameterUnit_Seconds, true},
+        { attackDuration,        0.0005, 0.05, 2, "attackDuration", "attackDuration", kAudioUnitParameterUnit_Seconds, true},
+        { decayDuration,         0.005, 0.005, 2, "decayDuration", "decayDuration", kAudioUnitParameterUnit_Seconds, true},
+        { sustainLevel,          0, 0.8, 1, "sustainLevel", "sustainLevel", kAudioUnitParameterUnit_Generic, true},
+        { releaseDuration,       0.004, 0.05, 2, "releaseDuration", "releaseDuration", kAudioUnitParameterUnit_Seconds, true},
+        { morph2Detuning,        -4, 0, 4, "morph2Detuning", "morph2Detuning", kAudioUnitParameterUnit_Generic, true},
+        { detuningMultiplier,    1, 1, 2, "detuningMultiplier", "detuningMultiplier", kAudioUnitParameterUnit_Generic, true},
+        { masterVolume,          0, 0.5, 2, "masterVolume", "masterVolume", kAudioUnitParameterUnit_Generic, true},
+        { bitCrushDepth,         1, 24, 24, "bitCrushDepth", "bitCrushDepth", kAudioUnitParameterUnit_Generic, false},// UNUSED
+        { bitCrushSampleRate,    2048, 48000, 48000, "bitCrushSampleRate", "bitCrushSampleRate", kAudioUnitParameterUnit_Hertz, true},
+        { autoPanAmount,         0, 0, 1, "autoPanAmount", "autoPanAmount", kAudioUnitParameterUnit_Generic, true},
+        { autoPanFrequency,      rate_min, 0.25, 10, "autoPanFrequency", "autoPanFrequency", kAudioUnitParameterUnit_Hertz, true},
+        { reverbOn,              0, 1, 1, "reverbOn", "reverbOn", kAudioUnitParameterUnit_Generic, true},
+        { reverbFeedback,        0, 0.5, 1, "reverbFeedback", "reverbFeedback", kAudioUnitParameterUnit_Generic, true},
+        { reverbHighPass,        80, 700, 900, "reverbHighPass", "reverbHighPass", kAudioUnitParameterUnit_Generic, true},
+        { reverbMix,             0, 0, 1, "reverbMix", "reverbMix", kAudioUnitParameterUnit_Generic, true},
+        { delayOn,               0, 0, 1, "delayOn", "delayOn", kAudioUnitParameterUnit_Generic, true},
+        { delayFeedback,         0, 0.1, 0.9, "delayFeedback", "delayFeedback", kAudioUnitParameterUnit_Generic, true},
+        { delayTime,             0.0003628117914, 0.25, 2.5, "delayTime", "delayTime", kAudioUnitParameterUnit_Seconds, true},
+        { delayMix,              0, 0.125, 1, "delayMix", "delayMix", kAudioUnitParameterUnit_Generic, true},
+        { lfo2Index,             0, 0, 3, "lfo2Index", "lfo2Index", kAudioUnitParameterUnit_Generic, false},
+        { lfo2Amplitude,         0, 0, 1, "lfo2Amplitude", "lfo2Amplitude", kAudioUnitParameterUnit_Generic, true},
+        { lfo2Rate,              rate_min, 0.25, rate_max, "lfo2Rate", "lfo2Rate", kAudioUnitParameterUnit_Generic, false},
+        { cutoffLFO,             0, 0, 3, "cutoffLFO", "cutoffLFO", kAudioUnitParameterUnit_Generic, false},
+        { resonanceLFO,          0, 0, 3, "resonanceLFO", "resonanceLFO", kAudioUnitParameterUnit_Generic, false},
+        { oscMixLFO,             0, 0, 3, "oscMixLFO", "oscMixLFO", kAudioUnitParameterUnit_Generic, false},
+        { reverbMixLFO,            0, 0, 3, "reverbMixLFO", "reverbMixLFO", kAudioUnitParameterUnit_Generic, false},
+        { decayLFO,              0, 0, 3, "decayLFO", "decayLFO", kAudioUnitParameterUnit_Generic, false},
+        { noiseLFO,              0, 0, 3, "noiseLFO", "noiseLFO", kAudioUnitParameterUnit_Generic, false},
+        { fmLFO,                 0, 0, 3, "fmLFO", "fmLFO", kAudioUnitParameterUnit_Generic, false},
+        { detuneLFO,             0, 0, 3, "detuneLFO", "detuneLFO", kAudioUnitParameterUnit_Generic, false},
+        { filterEnvLFO,          0, 0, 3, "filterEnvLFO", "filterEnvLFO", kAudioUnitParameterUnit_Generic, false},
+        { pitchLFO,              0, 0, 3, "pitchLFO", "pitchLFO", kAudioUnitParameterUnit_Generic, false},
+        { bitcrushLFO,           0, 0, 3, "bitcrushLFO", "bitcrushLFO", kAudioUnitParameterUnit_Generic, false},
+        { tremoloLFO,            0, 0, 3, "tremoloLFO", "tremoloLFO", kAudioUnitParameterUnit_Generic, false},
+        { arpDirection,          0, 1, 2, "arpDirection", "arpDirection", kAudioUnitParameterUnit_Generic, false},
+        { arpInterval,           0, 12, 12, "arpInterval", "arpInterval", kAudioUnitParameterUnit_Generic, false},
+        { arpIsOn,               0, 0, 1, "arpIsOn", "arpIsOn", kAudioUnitParameterUnit_Generic, false},
+        { arpOctave,             0, 1, 3, "arpOctave", "arpOctave", kAudioUnitParameterUnit_Generic, false},
+        { arpRate,               bpm_min, 120, bpm_max, "arpRate", "arpRate", kAudioUnitParameterUnit_BPM, false},
+        { arpIsSequencer,        0, 0, 1, "arpIsSequencer", "arpIsSequencer", kAudioUnitParameterUnit_Generic, false},
+        { arpTotalSteps,         1, 4, 16, "arpTotalSteps", "arpTotalSteps" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern00,       -12, 0, 12, "sequencerPattern00", "sequencerPattern00" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern01,       -12, 0, 12, "sequencerPattern01", "sequencerPattern01" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern02,       -12, 0, 12, "sequencerPattern02", "sequencerPattern02" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern03,       -12, 0, 12, "sequencerPattern03", "sequencerPattern03" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern04,       -12, 0, 12, "sequencerPattern04", "sequencerPattern04" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern05,       -12, 0, 12, "sequencerPattern05", "sequencerPattern05" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern06,       -12, 0, 12, "sequencerPattern06", "sequencerPattern06" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern07,       -12, 0, 12, "sequencerPattern07", "sequencerPattern07" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern08,       -12, 0, 12, "sequencerPattern08", "sequencerPattern08" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern09,       -12, 0, 12, "sequencerPattern09", "sequencerPattern09" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern10,       -12, 0, 12, "sequencerPattern10", "sequencerPattern10" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern11,       -12, 0, 12, "sequencerPattern11", "sequencerPattern11" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern12,       -12, 0, 12, "sequencerPattern12", "sequencerPattern12" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern13,       -12, 0, 12, "sequencerPattern13", "sequencerPattern13" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern14,       -12, 0, 12, "sequencerPattern14", "sequencerPattern14" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerPattern15,       -12, 0, 12, "sequencerPattern15", "sequencerPattern15" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost00,      0, 0, 1, "sequencerOctBoost00", "sequencerOctBoost00" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost01,      0, 0, 1, "sequencerOctBoost01", "sequencerOctBoost01" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost02,      0, 0, 1, "sequencerOctBoost02", "sequencerOctBoost02" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost03,      0, 0, 1, "sequencerOctBoost03", "sequencerOctBoost03" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost04,      0, 0, 1, "sequencerOctBoost04", "sequencerOctBoost04" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost05,      0, 0, 1, "sequencerOctBoost05", "sequencerOctBoost05" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost06,      0, 0, 1, "sequencerOctBoost06", "sequencerOctBoost06" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost07,      0, 0, 1, "sequencerOctBoost07", "sequencerOctBoost07" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost08,      0, 0, 1, "sequencerOctBoost08", "sequencerOctBoost08" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost09,      0, 0, 1, "sequencerOctBoost09", "sequencerOctBoost09" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost10,      0, 0, 1, "sequencerOctBoost10", "sequencerOctBoost10" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost11,      0, 0, 1, "sequencerOctBoost11", "sequencerOctBoost11" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost12,      0, 0, 1, "sequencerOctBoost12", "sequencerOctBoost12" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost13,      0, 0, 1, "sequencerOctBoost13", "sequencerOctBoost13" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost14,      0, 0, 1, "sequencerOctBoost14", "sequencerOctBoost14" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerOctBoost15,      0, 0, 1, "sequencerOctBoost15", "sequencerOctBoost15" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn00,        0, 0, 1, "sequencerNoteOn00", "sequencerNoteOn00" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn01,        0, 0, 1, "sequencerNoteOn01", "sequencerNoteOn01" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn02,        0, 0, 1, "sequencerNoteOn02", "sequencerNoteOn02" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn03,        0, 0, 1, "sequencerNoteOn03", "sequencerNoteOn03" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn04,        0, 0, 1, "sequencerNoteOn04", "sequencerNoteOn04" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn05,        0, 0, 1, "sequencerNoteOn05", "sequencerNoteOn05" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn06,        0, 0, 1, "sequencerNoteOn06", "sequencerNoteOn06" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn07,        0, 0, 1, "sequencerNoteOn07", "sequencerNoteOn07" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn08,        0, 0, 1, "sequencerNoteOn08", "sequencerNoteOn08" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn09,        0, 0, 1, "sequencerNoteOn09", "sequencerNoteOn09" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn10,        0, 0, 1, "sequencerNoteOn10", "sequencerNoteOn10" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn11,        0, 0, 1, "sequencerNoteOn11", "sequencerNoteOn11" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn12,        0, 0, 1, "sequencerNoteOn12", "sequencerNoteOn12" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn13,        0, 0, 1, "sequencerNoteOn13", "sequencerNoteOn13" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn14,        0, 0, 1, "sequencerNoteOn14", "sequencerNoteOn14" , kAudioUnitParameterUnit_Generic, false},
+        { sequencerNoteOn15,        0, 0, 1, "sequencerNoteOn15", "sequencerNoteOn15" , kAudioUnitParameterUnit_Generic, false},
+        { filterType,            0, 0, 2, "filterType", "filterType" , kAudioUnitParameterUnit_Generic, false},
+        { phaserMix,             0, 0, 1, "phaserMix", "phaserMix" , kAudioUnitParameterUnit_Generic, true},
+        { phaserRate,            1, 12, 300, "phaserRate", "phaserRate" , kAudioUnitParameterUnit_Hertz, true},
+        { phaserFeedback,        0, 0.0, 0.8, "phaserFeedback", "phaserFeedback" , kAudioUnitParameterUnit_Generic, true},
+        { phaserNotchWidth,      100, 800, 1000, "phaserNotchWidth", "phaserNotchWidth" , kAudioUnitParameterUnit_Hertz, true},
+        { monoIsLegato,          0, 0, 1, "monoIsLegato", "monoIsLegato" , kAudioUnitParameterUnit_Generic, false},
+        { widen,                 0, 0, 1, "widen", "widen" , kAudioUnitParameterUnit_Generic, true},//this is a toggle, but we smooth it for crossfade
+        
+        { compressorMasterRatio,      1, 20, 20, "master compressor ratio", "master compressor ratio", kAudioUnitParameterUnit_Generic, false},
+        { compressorReverbInputRatio, 1, 13, 20, "reverb input compressor ratio", "reverb input compressor ratio", kAudioUnitParameterUnit_Generic, false},
+        { compressorReverbWetRatio,   1, 13, 20, "reverb wet compressor ratio", "reverb wet compressor ratio", kAudioUnitParameterUnit_Generic, false},
+        
+        { compressorMasterThreshold,      -60, -9, 0, "master compressor threshold", "master compressor threshold", kAudioUnitParameterUnit_Generic, false},
+        { compressorReverbInputThreshold, -60, -8.5, 0, "reverb input compressor threshold", "reverb input compressor threshold", kAudioUnitParameterUnit_Generic, false},
+        { compressorReverbWetThreshold,   -60, -8, 0, "reverb wet compressor threshold", "reverb wet compressor threshold", kAudioUnitParameterUnit_Generic, false},
+        
+        { compressorMasterAttack,      0, 0.001, 0.01, "master compressor attack", "master compressor attack", kAudioUnitParameterUnit_Generic, false},
+        { compressorReverbInputAttack, 0, 0.001, 0.01, "reverb input compressor attack", "reverb input compressor attack", kAudioUnitParameterUnit_Generic, false},
+        { compressorReverbWetAttack,   0, 0.001, 0.01, "reverb wet compressor attack", "reverb wet compressor attack", kAudioUnitParameterUnit_Generic, false},
+        
+        { compressorMasterRelease,      0, 0.15, 0.5, "master compressor release", "master compressor release", kAudioUnitParameterUnit_Generic, false},
+        { compressorReverbInputRelease, 0, 0.225, 0.5, "reverb input compressor release", "reverb input compressor release", kAudioUnitParameterUnit_Generic, false},
+        { compressorReverbWetRelease,   0, 0.15, 0.5, "reverb wet compressor release", "reverb wet compressor release", kAudioUnitParameterUnit_Generic, false},
+        
+        { compressorMasterMakeupGain, 0.5, 2, 4, "master compressor makeup gain", "master compressor makeup gain", kAudioUnitParameterUnit_Generic, false},
+        { compressorReverbInputMakeupGain, 0.5, 1.88, 4, "reverb input compressor makeup gain", "reverb input compressor makeup gain", kAudioUnitParameterUnit_Generic, false},
+        { compressorReverbWetMakeupGain, 0.5, 1.88, 4, "reverb wet compressor makeup gain", "reverb wet compressor makeup gain", kAudioUnitParameterUnit_Generic, false},
+        
+        { delayInputCutoffTrackingRatio, 0.5, 0.75, 1, "delayInputCutoffTrackingRatio", "delayInputCutoffTrackingRatio", kAudioUnitParameterUnit_Hertz, false},
+        { delayInputResonance, 0, 0.0, 0.98, "delayInputResonance", "delayInputResonance", kAudioUnitParameterUnit_Generic, false},
+        { tempoSyncToArpRate, 0, 1, 1, "tempoSyncToArpRate", "tempoSyncToArpRate", kAudioUnitParameterUnit_Generic, false},
+        
+        { pitchbend,              0, 8192, 16383, "pitchbend", "pitchbend", kAudioUnitParameterUnit_Generic, false},
+        { pitchbendMinSemitones,  -24, -12, 0, "pitchbendMinSemitones", "pitchbendMinSemitones", kAudioUnitParameterUnit_Generic, false},
+        { pitchbendMaxSemitones,  0, 12, 24, "pitchbendMaxSemitones", "pitchbendMaxSemitones", kAudioUnitParameterUnit_Generic, false},
+        
+        { frequencyA4,  410, 440, 470, "frequencyA4", "frequencyA4", kAudioUnitParameterUnit_Hertz, true},
+        { portamentoHalfTime, 0.000001, 0.1, 0.99, "portamentoHalfTime", "portamentoHalfTime", kAudioUnitParameterUnit_Generic, true},
+
+        /* DEPRECATED -1 = no override, else = index into bandlimited wavetable */
+        { oscBandlimitIndexOverride, -1, -1, (S1_NUM_BANDLIMITED_FTABLES-1), "oscBandlimitIndexOverride", "oscBandlimitIndexOverride", kAudioUnitParameterUnit_Generic, false},
+        { oscBandlimitEnable, 0, 0, 1, "oscBandlimitEnable", "oscBandlimitEnable", kAudioUnitParameterUnit_Generic, false},
+
+        { arpSeqTempoMultiplier, bars_min, 0.25, bars_max, "arpSeqTempoMultiplier", "arpSeqTempoMultiplier", kAudioUnitParameterUnit_Generic, false},
+
+        { transpose, -24, 0, 24, "transpose", "transpose", kAudioUnitParameterUnit_Generic, false},
+
+        { adsrPitchTracking, 0, 0, 1, "adsrPitchTracking", "adsrPitchTracking", kAudioUnitParameterUnit_Generic, true},
+
+        { oversampling, 0, 0, 2, "oversampling", "oversampling", kAudioUnitParameterUnit_Generic, false}
+    }};
+
+    static constexpr const S1ParameterInfo &info(S1Parameter parameter) {
+        return kInfo[parameter];
+    }
+};
+
+static_assert([] {
+    for (int i = 0; i < S1ParameterTable::kCount; i++) {
+        if (S1ParameterTable::kInfo[i].parameter != i) {
+            return false;
+        }
+    }
+    return true;
+}(), "S1ParameterTable::kInfo must be in S1Parameter order");
+
+constexpr int S1PortamentoParameterCount() {
+    int count = 0;
+    for (const S1ParameterInfo &info : S1ParameterTable::kInfo) {
+        count += info.usePortamento ? 1 : 0;
+    }
+    return count;
+}
+
+// the parameters that use portamento, numbered in S1Parameter order
+struct S1PortamentoParameters {
+
+    static constexpr int kCount = S1PortamentoParameterCount();
+
+    std::array<S1Parameter, kCount> parameters {};
+
+    // number of each parameter, or -1 if it does not use portamento
+    std::array<int, S1ParameterTable::kCount> index {};
+
+    constexpr S1PortamentoParameters() {
+        int next = 0;
+        for (int i = 0; i < S1ParameterTable::kCount; i++) {
+            if (S1ParameterTable::kInfo[i].usePortamento) {
+                parameters[next] = S1ParameterTable::kInfo[i].parameter;
+                index[i] = next++;
+            } else {
+                index[i] = -1;
+            }
+        }
+    }
+};
+
+inline constexpr S1PortamentoParameters S1Portamento {};
+
+#endif
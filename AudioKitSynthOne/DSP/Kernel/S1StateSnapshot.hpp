@@ -0,0 +1,40 @@
+//
+//  S1StateSnapshot.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  DSP state the UI displays: held notes, playing voices and the arp beat counter.
+//  Published by the render thread once per buffer when it changed, polled by the main thread.
+
+#pragma once
+
+#import <array>
+#import <cstdint>
+#import "S1AudioUnit.h"
+#import "S1TripleBuffer.hpp"
+
+#ifdef __cplusplus
+
+struct S1StateSnapshot {
+
+    // bumped on every publish
+    uint64_t version = 0;
+
+    // bumped when the corresponding state changed, so a reader that skipped a snapshot still sees the change
+    uint32_t heldNotesVersion = 0;
+    uint32_t beatCounterVersion = 0;
+    uint32_t playingNotesVersion = 0;
+
+    std::array<uint64_t, S1_NUM_MIDI_NOTES / 64> heldNoteBits {};
+    int heldNotesCount = 0;
+    int beatCounter = 0;
+    PlayingNotes playingNotes {};
+
+    inline bool isHeld(int noteNumber) const {
+        return (heldNoteBits[noteNumber >> 6] >> (noteNumber & 63)) & 1;
+    }
+};
+
+#endif
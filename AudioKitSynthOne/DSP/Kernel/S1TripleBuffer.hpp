@@ -0,0 +1,63 @@
+//
+//  S1TripleBuffer.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Lock-free handoff of a value from one thread to another.
+
+#pragma once
+
+#import <array>
+#import <atomic>
+
+#ifdef __cplusplus
+
+// Single writer, single reader.  The writer fills back() and publishes it; the reader takes the
+// latest published buffer.  Neither side waits, and a reader that falls behind only skips buffers.
+template<typename T>
+class S1TripleBuffer {
+
+public:
+
+    S1TripleBuffer(const S1TripleBuffer&) = delete;
+
+    S1TripleBuffer() = default;
+
+    // WRITER: buffer to fill completely before publish(); its previous contents are stale
+    inline T &back() {
+        return mBuffers[mBackIndex];
+    }
+
+    // WRITER
+    inline void publish() {
+        mBackIndex = mMiddle.exchange(mBackIndex | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    // READER: returns true if a buffer was published since the last call; front() is then the latest
+    inline bool update() {
+        if ((mMiddle.load(std::memory_order_relaxed) & kFresh) == 0) {
+            return false;
+        }
+        mFrontIndex = mMiddle.exchange(mFrontIndex, std::memory_order_acq_rel) & kIndexMask;
+        return true;
+    }
+
+    // READER
+    inline const T &front() const {
+        return mBuffers[mFrontIndex];
+    }
+
+private:
+
+    static constexpr int kIndexMask = 3;
+    static constexpr int kFresh = 4;
+
+    std::array<T, 3> mBuffers {};
+    alignas(64) std::atomic<int> mMiddle {1};
+    int mBackIndex = 0;
+    alignas(64) int mFrontIndex = 2;
+};
+
+#endif
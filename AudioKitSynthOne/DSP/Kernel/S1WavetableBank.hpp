@@ -0,0 +1,126 @@
+//
+//  S1WavetableBank.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Read-only wavetables of the oscillators at one sample rate: the band-limited waveform tables, their band
+//  frequencies and the sine.  Kernels share a bank through shared_ptr and never write to it; shared() finds the
+//  bank of the same tables that any kernel of the process still holds
+
+#pragma once
+
+#import <algorithm>
+#import <array>
+#import <cstring>
+#import <memory>
+#import <mutex>
+#import <vector>
+#import "AudioKit/AKSoundpipeKernel.hpp"
+#import "S1AudioUnit.h"
+
+#define S1_FTABLE_SIZE (4096)
+#define S1_NUM_WAVEFORMS (4)
+#define S1_NUM_WAVETABLES (S1_NUM_WAVEFORMS * S1_NUM_BANDLIMITED_FTABLES)
+
+#ifdef __cplusplus
+
+class S1WavetableBank {
+
+public:
+
+    S1WavetableBank(const S1WavetableBank&) = delete;
+
+    // samples: S1_NUM_WAVETABLES tables of S1_FTABLE_SIZE samples in tableIndex order.
+    // bandlimitFrequencies: S1_NUM_BANDLIMITED_FTABLES
+    S1WavetableBank(double sampleRate, const float *samples, const float *bandlimitFrequencies) : mSampleRate(sampleRate) {
+
+        // sp_ftbl_create sets the phase increments of sampleRate
+        sp_data *sp;
+        sp_create(&sp);
+        sp->sr = sampleRate;
+        for (int i = 0; i < S1_NUM_WAVETABLES; i++) {
+            sp_ftbl_create(sp, &mWavetables[i], S1_FTABLE_SIZE);
+            std::copy(samples + i * S1_FTABLE_SIZE, samples + (i + 1) * S1_FTABLE_SIZE, mWavetables[i]->tbl);
+        }
+        sp_ftbl_create(sp, &mSine, S1_FTABLE_SIZE);
+        sp_gen_sine(sp, mSine);
+        sp_destroy(&sp);
+        std::copy(bandlimitFrequencies, bandlimitFrequencies + S1_NUM_BANDLIMITED_FTABLES, mBandlimitFrequencies.begin());
+    }
+
+    // ANY THREAD but the render thread: the bank of these tables at sampleRate, shared with every kernel holding it
+    static std::shared_ptr<const S1WavetableBank> shared(double sampleRate, const float *samples, const float *bandlimitFrequencies) {
+        static std::mutex mutex;
+        static std::vector<std::weak_ptr<const S1WavetableBank>> banks;
+        std::lock_guard<std::mutex> lock(mutex);
+        banks.erase(std::remove_if(banks.begin(), banks.end(), [](const std::weak_ptr<const S1WavetableBank> &bank) {
+            return bank.expired();
+        }), banks.end());
+        for (const std::weak_ptr<const S1WavetableBank> &weakBank : banks) {
+            std::shared_ptr<const S1WavetableBank> bank = weakBank.lock();
+            if (bank && bank->holds(sampleRate, samples, bandlimitFrequencies)) {
+                return bank;
+            }
+        }
+        auto bank = std::make_shared<const S1WavetableBank>(sampleRate, samples, bandlimitFrequencies);
+        banks.push_back(bank);
+        return bank;
+    }
+
+    // the tables of bank at sampleRate
+    static std::shared_ptr<const S1WavetableBank> shared(double sampleRate, const S1WavetableBank &bank) {
+        std::vector<float> samples(S1_NUM_WAVETABLES * S1_FTABLE_SIZE);
+        for (int i = 0; i < S1_NUM_WAVETABLES; i++) {
+            std::copy(bank.mWavetables[i]->tbl, bank.mWavetables[i]->tbl + S1_FTABLE_SIZE, samples.begin() + i * S1_FTABLE_SIZE);
+        }
+        return shared(sampleRate, samples.data(), bank.bandlimitFrequencies());
+    }
+
+    ~S1WavetableBank() {
+        for (sp_ftbl *&table : mWavetables) {
+            sp_ftbl_destroy(&table);
+        }
+        sp_ftbl_destroy(&mSine);
+    }
+
+    double sampleRate() const {
+        return mSampleRate;
+    }
+
+    // Soundpipe takes non-const tables; oscillators only read them
+    sp_ftbl *wavetable(int tableIndex) const {
+        return mWavetables[tableIndex];
+    }
+
+    sp_ftbl *sine() const {
+        return mSine;
+    }
+
+    const float *bandlimitFrequencies() const {
+        return mBandlimitFrequencies.data();
+    }
+
+private:
+
+    bool holds(double sampleRate, const float *samples, const float *bandlimitFrequencies) const {
+        if (sampleRate != mSampleRate ||
+            !std::equal(mBandlimitFrequencies.begin(), mBandlimitFrequencies.end(), bandlimitFrequencies)) {
+            return false;
+        }
+        for (int i = 0; i < S1_NUM_WAVETABLES; i++) {
+            if (memcmp(mWavetables[i]->tbl, samples + i * S1_FTABLE_SIZE, S1_FTABLE_SIZE * sizeof(float)) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    double mSampleRate;
+    std::array<sp_ftbl *, S1_NUM_WAVETABLES> mWavetables;
+    std::array<float, S1_NUM_BANDLIMITED_FTABLES> mBandlimitFrequencies;
+    sp_ftbl *mSine;
+};
+
+#endif
@@ -0,0 +1,226 @@
+//
+//  S1Envelope.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Attack/decay/sustain/release envelope of a voice.  Every segment is a one-pole approach to its target, so a
+//  sample costs one multiply-add; the pole of each segment is precomputed in a Shape whenever its duration changes.
+//  The attack and release aim past their end levels, so both end on a sample count computed when they start, and
+//  segments are rendered kBlockSize samples at a time.  The stage is exposed so a voice knows the sample its
+//  release ends.
+
+#pragma once
+
+#import <algorithm>
+#import <cmath>
+#import <climits>
+
+#ifdef __cplusplus
+
+class S1Envelope {
+
+public:
+
+    enum Stage { stageOff, stageAttack, stageDecay, stageRelease };
+
+    // samples rendered at a time; a gate change re-renders from the sample it arrives on
+    static constexpr int kBlockSize = 32;
+
+    // the durations of an envelope at a rate and the poles of its segments
+    struct Shape {
+        float sampleRate = 0.f;
+        float attackDuration = -1.f;
+        float decayDuration = -1.f;
+        float sustainLevel = 0.f;
+        float releaseDuration = -1.f;
+        float attackCoefficient = 0.f;
+        float decayCoefficient = 0.f;
+        float releaseCoefficient = 0.f;
+
+        // PER BUFFER: recomputes only the poles whose duration or rate changed
+        void update(float attack, float decay, float sustain, float release, float rate) {
+            if (rate != sampleRate) {
+                sampleRate = rate;
+                attackDuration = decayDuration = releaseDuration = -1.f;
+            }
+            if (attack != attackDuration) {
+                attackDuration = attack;
+                attackCoefficient = coefficient(attack * kAttackTimeConstant, rate);
+            }
+            if (decay != decayDuration) {
+                decayDuration = decay;
+                decayCoefficient = coefficient(decay, rate);
+            }
+            if (release != releaseDuration) {
+                releaseDuration = release;
+                releaseCoefficient = coefficient(release, rate);
+            }
+            sustainLevel = sustain;
+        }
+    };
+
+    // the stage of the last sample returned by next
+    Stage stage() const {
+        return mCursor > mTransitionFrame ? mStage : mBlockStage;
+    }
+
+    // the last sample returned by next
+    float level() const {
+        return mOutput;
+    }
+
+    // a rising gate starts the attack from the current level; the gate held high (legato) does not retrigger
+    void gate(bool isOn) {
+        if (isOn && !mIsGateOn) {
+            startSegment(stageAttack);
+        } else if (!isOn && mIsGateOn && stage() != stageOff) {
+            startSegment(stageRelease);
+        }
+        mIsGateOn = isOn;
+    }
+
+    void reset() {
+        mStage = mBlockStage = stageOff;
+        mLevel = mOutput = 0.f;
+        mCursor = mTransitionFrame = kBlockSize;
+        mIsGateOn = false;
+    }
+
+    // RENDER THREAD: the level of the next sample.
+    // decayDuration is the modulated decay of shape; the decay follows it a block at a time, recomputing its pole
+    // whenever it changes
+    inline float next(const Shape &shape, float decayDuration) {
+        if (mCursor == kBlockSize) {
+            render(shape, decayDuration);
+        }
+        mOutput = mBlock[mCursor++];
+        return mOutput;
+    }
+
+private:
+
+    // the attack overshoots to kAttackTarget so it reaches 1 in attackDuration: 1.5 * (1 - e^(-t/tau)) = 1 at t = tau * ln(3)
+    static constexpr float kAttackTarget = 1.5f;
+    static constexpr float kAttackTimeConstant = 0.910239227f; // 1 / ln(3)
+
+    // the release undershoots to kReleaseTarget so it reaches 0, in about 4.6 time constants from full level
+    static constexpr float kReleaseTarget = -0.01f;
+
+    // pole of a one-pole segment with time constant tau seconds; 0 jumps to the target
+    static float coefficient(float tau, float sampleRate) {
+        return tau > 0.f && sampleRate > 0.f ? expf(-1.f / (tau * sampleRate)) : 0.f;
+    }
+
+    // samples a one-pole segment with pole c takes from level to reach end on its way to target, at least 1
+    static int segmentLength(float level, float target, float end, float c) {
+        if (c <= 0.f) {
+            return 1;
+        }
+        if (c >= 1.f) {
+            return INT_MAX;
+        }
+        const double length = std::ceil(std::log(double(target - end) / double(target - level)) / std::log(double(c)));
+        return length < 1. ? 1 : length > double(INT_MAX) ? INT_MAX : int(length);
+    }
+
+    // a gate change: the segment starts from the current level and the rest of the block is rendered again
+    void startSegment(Stage stage) {
+        mLevel = mOutput;
+        mStage = mBlockStage = stage;
+        mSegmentCoefficient = -1.f;
+        mCursor = mTransitionFrame = kBlockSize;
+    }
+
+    // the pole of shape unless decayDuration is modulated
+    inline void updateDecayCoefficient(const Shape &shape, float decayDuration) {
+        mDecayDuration = decayDuration;
+        mDecaySampleRate = shape.sampleRate;
+        mDecayCoefficient = decayDuration == shape.decayDuration ?
+            shape.decayCoefficient : coefficient(decayDuration, shape.sampleRate);
+    }
+
+    // the attack or release in mStage with pole c: render up to its end, then step to next.
+    // a changed pole recounts the samples left from the current level
+    inline int renderSegment(int frame, float c, float target, float end, Stage next) {
+        if (c != mSegmentCoefficient) {
+            mSegmentCoefficient = c;
+            mSegmentLength = segmentLength(mLevel, target, end, c);
+        }
+        const int count = std::min(mSegmentLength, kBlockSize - frame);
+        float level = mLevel;
+        for (int i = frame; i < frame + count; ++i) {
+            level = target + (level - target) * c;
+            mBlock[i] = level;
+        }
+        frame += count;
+        mSegmentLength -= count;
+        if (mSegmentLength == 0) {
+            level = mBlock[frame - 1] = end;
+            mStage = next;
+            mTransitionFrame = frame;
+        }
+        mLevel = level;
+        return frame;
+    }
+
+    // RENDER THREAD: the next kBlockSize samples.  A block holds at most one stage change, as only a gate change
+    // starts a segment and the decay has no end
+    void render(const Shape &shape, float decayDuration) {
+        mBlockStage = mStage;
+        mTransitionFrame = kBlockSize;
+        int frame = 0;
+        while (frame < kBlockSize) {
+            switch (mStage) {
+                case stageOff:
+                    std::fill(mBlock + frame, mBlock + kBlockSize, 0.f);
+                    mLevel = 0.f;
+                    frame = kBlockSize;
+                    break;
+
+                case stageAttack:
+                    frame = renderSegment(frame, shape.attackCoefficient, kAttackTarget, 1.f, stageDecay);
+                    break;
+
+                case stageDecay: {
+                    if (decayDuration != mDecayDuration || shape.sampleRate != mDecaySampleRate) {
+                        updateDecayCoefficient(shape, decayDuration);
+                    }
+                    const float sustain = shape.sustainLevel;
+                    const float c = mDecayCoefficient;
+                    float level = mLevel;
+                    for (; frame < kBlockSize; ++frame) {
+                        level = sustain + (level - sustain) * c;
+                        mBlock[frame] = level;
+                    }
+                    mLevel = level;
+                    break;
+                }
+
+                case stageRelease:
+                    frame = renderSegment(frame, shape.releaseCoefficient, kReleaseTarget, 0.f, stageOff);
+                    break;
+            }
+        }
+        mCursor = 0;
+    }
+
+    float mBlock[kBlockSize] = {0.f};
+    int mCursor = kBlockSize;
+    // mBlock holds mBlockStage up to mTransitionFrame and mStage from it
+    Stage mBlockStage = stageOff;
+    int mTransitionFrame = kBlockSize;
+    Stage mStage = stageOff;
+    // level at the end of mBlock
+    float mLevel = 0.f;
+    float mOutput = 0.f;
+    float mSegmentCoefficient = -1.f;
+    int mSegmentLength = 0;
+    float mDecayDuration = -1.f;
+    float mDecaySampleRate = 0.f;
+    float mDecayCoefficient = 0.f;
+    bool mIsGateOn = false;
+};
+
+#endif
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#import <array>
+#import <utility>
 #import <vector>
 #import <list>
 #import <string>
@@ -16,6 +18,8 @@
 #import "S1AudioUnit.h"
 #import "S1Parameter.h"
 #import "S1Rate.hpp"
+#import "S1DSPArena.hpp"
+#import "S1Envelope.hpp"
 
 #ifdef __cplusplus
 
@@ -27,15 +31,14 @@ struct S1NoteState {
     
     enum NoteStateStage { stageOff, stageOn, stageRelease };
     NoteStateStage stage = stageOff;
-    
-    float internalGate = 0;
 
     // velocity stores the original velocity...not used in "process"
     int velocity;
 
-    // amp is a transform of velocity and is used in "process"
+    // level of the amplitude envelope; the generator amplitudes carry the velocity
     float amp = 0;
 
+    // level of the filter cutoff envelope
     float filter = 0;
 
     // -1 denotes an invalid note number
@@ -43,12 +46,28 @@ struct S1NoteState {
 
     // used for frequency look up and UI
     int transpose = 0;
+
+    // frequency of the note, set by startNoteHelper.  Oscillator freq fields are derived from it in run()
+    float noteFrequency = 0.f;
+
+    // OSC1, OSC2, SUB and FM frequencies without the pitch LFO and detune LFO.
+    // Recomputed only when the base frequency, detuningMultiplier or kernel pitchRatios change
+    struct FrequencyCache {
+        float baseFrequency = -1.f;
+        float detuningMultiplier = -1.f;
+        uint32_t pitchRatiosVersion = 0;
+        float osc1 = 0.f;
+        float osc2 = 0.f;
+        float sub = 0.f;
+        float fm = 0.f;
+    };
+    FrequencyCache frequencyCache;
     
     //Amplitude ADSR
-    sp_adsr *adsr;
+    S1Envelope ampEnvelope;
     
     //Filter Cutoff Frequency ADSR
-    sp_adsr *fadsr;
+    S1Envelope filterEnvelope;
     
     //Morphing Oscillator 1 & 2
     sp_oscmorph2d *oscmorph1;
@@ -71,18 +90,48 @@ struct S1NoteState {
     sp_butbp *bandPass;
     sp_crossfade *filterCrossFade;
     
+    // arena bytes of the modules above
+    static constexpr size_t kArenaFootprint = S1DSPArena::footprint<sp_oscmorph2d, sp_oscmorph2d,
+        sp_crossfade, sp_osc, sp_fosc, sp_noise, sp_moogladder, sp_buthp, sp_butbp, sp_crossfade>();
+
     inline float getParam(S1Parameter param);
     inline int sampleRate() const;
 
-    void init();
+    // carves the modules from arena; they are released with it
+    void init(S1DSPArena &arena);
 
-    void destroy();
+    void updateSampleRate();
     
     void clear();
 
     void startNoteHelper(int noteNumber, int velocity, float frequency);
 
-    void run(int frameIndex, float *outL, float *outR);
+    // generator amplitudes of a MIDI velocity
+    void setVelocity(int velocity);
+
+    // RENDER THREAD: edges of the envelope gate.  Raising a gate already on (legato) keeps the envelopes going
+    void gateOn();
+    void gateOff();
+
+    // generators that are skipped when silent, as bits of the Generators of run
+    enum Generator : int {
+        subGenerator = 1,
+        squareSubGenerator = 2,
+        fmGenerator = 4,
+        noiseGenerator = 8,
+        kGeneratorCombinations = 16
+    };
+
+    // lfoFrameIndex is the frame of the kernel's current LFO control block.
+    // IsMono: the monophonic note, following the kernel's glide instead of noteFrequency.
+    // FilterType: the filterType parameter.  Generators: the audible Generator bits
+    template <bool IsMono, int FilterType, int Generators>
+    void run(int frameIndex, int lfoFrameIndex, float *outL, float *outR);
+
+    using Renderer = void (S1NoteState::*)(int frameIndex, int lfoFrameIndex, float *outL, float *outR);
+
+    // PER BUFFER: the run specialization for the audible Generator bits and a filterType of 0...2
+    static Renderer renderer(bool isMono, int generators, int filterType);
 };
 
 #endif
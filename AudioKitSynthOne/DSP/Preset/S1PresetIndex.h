@@ -0,0 +1,72 @@
+//
+//  S1PresetIndex.h
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Binary index of the preset banks, memory-mapped when opened: names, banks and positions for browsing and search,
+//  the JSON of each preset to decode it on demand, and its S1ParameterCount DSP parameters to load it without decoding.
+
+#pragma once
+
+#import <Foundation/Foundation.h>
+#import "S1Parameter.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface S1PresetIndex : NSObject
+
+// nil if the file is missing, malformed, written for another S1ParameterCount, or its fingerprint differs
+- (nullable instancetype)initWithContentsOfFile:(NSString *)path fingerprint:(uint64_t)fingerprint;
+
+@property (nonatomic, readonly) NSInteger count;
+@property (nonatomic, readonly) uint64_t fingerprint;
+
+- (NSString *)nameAtIndex:(NSInteger)index;
+- (NSString *)uidAtIndex:(NSInteger)index;
+- (NSString *)bankAtIndex:(NSInteger)index;
+- (NSInteger)positionAtIndex:(NSInteger)index;
+- (NSInteger)categoryAtIndex:(NSInteger)index;
+- (BOOL)isFavoriteAtIndex:(NSInteger)index;
+- (NSString *)userTextAtIndex:(NSInteger)index;
+
+// NSNotFound if the bank has no preset at position
+- (NSInteger)indexOfPresetInBank:(NSString *)bank position:(NSInteger)position NS_SWIFT_NAME(indexOfPreset(bank:position:));
+
+// in index order
+- (NSIndexSet *)indexesOfPresetsInBank:(NSString *)bank NS_SWIFT_NAME(indexesOfPresets(bank:));
+
+// JSON object of one preset; references the mapped file, which stays mapped while the data is alive
+- (NSData *)presetDataAtIndex:(NSInteger)index;
+
+// S1ParameterCount values; NAN for parameters the preset does not store.  Valid for the lifetime of the index
+- (const float *)parametersAtIndex:(NSInteger)index NS_RETURNS_INNER_POINTER;
+
+// presets whose search text contains text, ignoring case
+- (NSIndexSet *)indexesOfPresetsContainingText:(NSString *)text NS_SWIFT_NAME(indexesOfPresets(containing:));
+
+@end
+
+@interface S1PresetIndexWriter : NSObject
+
+// parameters: S1ParameterCount values.  Search matches the name and userText
+- (void)addPresetWithName:(NSString *)name
+                      uid:(NSString *)uid
+                     bank:(NSString *)bank
+                 position:(NSInteger)position
+                 category:(NSInteger)category
+                 favorite:(BOOL)favorite
+                 userText:(NSString *)userText
+                     data:(NSData *)data
+               parameters:(const float *)parameters;
+
+// copies one preset of another index without decoding it
+- (void)addPresetAtIndex:(NSInteger)index fromIndex:(S1PresetIndex *)presetIndex NS_SWIFT_NAME(addPreset(at:from:));
+
+// writes to a temporary file and moves it into place, so a reader never maps a partial index
+- (BOOL)writeToFile:(NSString *)path fingerprint:(uint64_t)fingerprint;
+
+@end
+
+NS_ASSUME_NONNULL_END
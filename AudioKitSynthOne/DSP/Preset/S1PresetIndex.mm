@@ -0,0 +1,258 @@
+//
+//  S1PresetIndex.mm
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+
+#import <cstring>
+#import <string>
+#import <vector>
+#import "S1PresetIndex.h"
+
+// File layout: header, entries, parameters (presetCount * parameterCount floats), strings (UTF-8, not terminated)
+static const uint32_t S1PresetIndexMagic = 'S1PI';
+static const uint32_t S1PresetIndexVersion = 2;
+
+typedef struct S1PresetIndexHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t parameterCount;
+    uint32_t presetCount;
+    uint64_t fingerprint;
+    uint32_t entriesOffset;
+    uint32_t parametersOffset;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+} S1PresetIndexHeader;
+
+// range of the strings section
+typedef struct S1PresetIndexString {
+    uint32_t offset;
+    uint32_t length;
+} S1PresetIndexString;
+
+typedef struct S1PresetIndexEntry {
+    S1PresetIndexString name;
+    S1PresetIndexString uid;
+    S1PresetIndexString bank;
+    S1PresetIndexString userText;
+    S1PresetIndexString searchText;
+    S1PresetIndexString data;
+    int32_t position;
+    int32_t category;
+    uint32_t flags;
+} S1PresetIndexEntry;
+
+static const uint32_t S1PresetIndexFavorite = 1;
+
+@implementation S1PresetIndex {
+    NSData *_data;
+    const S1PresetIndexEntry *_entries;
+    const float *_parameters;
+    const char *_strings;
+}
+
+- (nullable instancetype)initWithContentsOfFile:(NSString *)path fingerprint:(uint64_t)fingerprint {
+    self = [super init];
+    if (!self) {
+        return nil;
+    }
+    _data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedAlways error:nil];
+    if (_data.length < sizeof(S1PresetIndexHeader)) {
+        return nil;
+    }
+    const char *bytes = (const char *)_data.bytes;
+    const uint64_t size = _data.length;
+    const S1PresetIndexHeader *header = (const S1PresetIndexHeader *)bytes;
+    if (header->magic != S1PresetIndexMagic || header->version != S1PresetIndexVersion ||
+        header->parameterCount != S1ParameterCount || header->fingerprint != fingerprint) {
+        return nil;
+    }
+    const uint64_t count = header->presetCount;
+    if ((uint64_t)header->entriesOffset + count * sizeof(S1PresetIndexEntry) > size ||
+        (uint64_t)header->parametersOffset + count * S1ParameterCount * sizeof(float) > size ||
+        (uint64_t)header->stringsOffset + header->stringsSize > size ||
+        header->entriesOffset % alignof(S1PresetIndexEntry) != 0 || header->parametersOffset % alignof(float) != 0) {
+        return nil;
+    }
+    _entries = (const S1PresetIndexEntry *)(bytes + header->entriesOffset);
+    _parameters = (const float *)(bytes + header->parametersOffset);
+    _strings = bytes + header->stringsOffset;
+
+    // validate the string ranges once so the accessors don't have to
+    for (uint64_t i = 0; i < count; i++) {
+        const S1PresetIndexEntry &entry = _entries[i];
+        for (const S1PresetIndexString &string : {entry.name, entry.uid, entry.bank, entry.userText, entry.searchText, entry.data}) {
+            if ((uint64_t)string.offset + string.length > header->stringsSize) {
+                return nil;
+            }
+        }
+    }
+    _count = (NSInteger)count;
+    _fingerprint = fingerprint;
+    return self;
+}
+
+- (NSString *)stringFrom:(S1PresetIndexString)string {
+    return [[NSString alloc] initWithBytes:_strings + string.offset length:string.length encoding:NSUTF8StringEncoding] ?: @"";
+}
+
+- (NSString *)nameAtIndex:(NSInteger)index {
+    return [self stringFrom:_entries[index].name];
+}
+
+- (NSString *)uidAtIndex:(NSInteger)index {
+    return [self stringFrom:_entries[index].uid];
+}
+
+- (NSString *)bankAtIndex:(NSInteger)index {
+    return [self stringFrom:_entries[index].bank];
+}
+
+- (NSInteger)positionAtIndex:(NSInteger)index {
+    return _entries[index].position;
+}
+
+- (NSInteger)categoryAtIndex:(NSInteger)index {
+    return _entries[index].category;
+}
+
+- (BOOL)isFavoriteAtIndex:(NSInteger)index {
+    return (_entries[index].flags & S1PresetIndexFavorite) != 0;
+}
+
+- (NSString *)userTextAtIndex:(NSInteger)index {
+    return [self stringFrom:_entries[index].userText];
+}
+
+- (BOOL)isPresetAtIndex:(NSInteger)index inBank:(const char *)bankName length:(size_t)bankLength {
+    const S1PresetIndexString bank = _entries[index].bank;
+    return bank.length == bankLength && memcmp(_strings + bank.offset, bankName, bankLength) == 0;
+}
+
+- (NSInteger)indexOfPresetInBank:(NSString *)bank position:(NSInteger)position {
+    const char *bankName = bank.UTF8String;
+    const size_t bankLength = strlen(bankName);
+    for (NSInteger i = 0; i < _count; i++) {
+        if (_entries[i].position == position && [self isPresetAtIndex:i inBank:bankName length:bankLength]) {
+            return i;
+        }
+    }
+    return NSNotFound;
+}
+
+- (NSIndexSet *)indexesOfPresetsInBank:(NSString *)bank {
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    const char *bankName = bank.UTF8String;
+    const size_t bankLength = strlen(bankName);
+    for (NSInteger i = 0; i < _count; i++) {
+        if ([self isPresetAtIndex:i inBank:bankName length:bankLength]) {
+            [indexes addIndex:i];
+        }
+    }
+    return indexes;
+}
+
+- (NSData *)presetDataAtIndex:(NSInteger)index {
+    const S1PresetIndexString string = _entries[index].data;
+    NSData *mapping = _data;
+    return [[NSData alloc] initWithBytesNoCopy:(void *)(_strings + string.offset)
+                                        length:string.length
+                                   deallocator:^(void *bytes, NSUInteger length) {
+                                       (void)mapping;
+                                   }];
+}
+
+- (const float *)parametersAtIndex:(NSInteger)index {
+    return _parameters + index * S1ParameterCount;
+}
+
+- (NSIndexSet *)indexesOfPresetsContainingText:(NSString *)text {
+    NSMutableIndexSet *indexes = [NSMutableIndexSet indexSet];
+    const char *needle = text.lowercaseString.UTF8String;
+    const size_t needleLength = strlen(needle);
+    for (NSInteger i = 0; i < _count; i++) {
+        const S1PresetIndexString string = _entries[i].searchText;
+        if (memmem(_strings + string.offset, string.length, needle, needleLength) != nullptr) {
+            [indexes addIndex:i];
+        }
+    }
+    return indexes;
+}
+
+@end
+
+@implementation S1PresetIndexWriter {
+    std::vector<S1PresetIndexEntry> _entries;
+    std::vector<float> _parameters;
+    std::string _strings;
+}
+
+- (S1PresetIndexString)addString:(NSData *)data {
+    const S1PresetIndexString string = {(uint32_t)_strings.size(), (uint32_t)data.length};
+    _strings.append((const char *)data.bytes, data.length);
+    return string;
+}
+
+- (S1PresetIndexString)addUTF8String:(NSString *)string {
+    return [self addString:[string dataUsingEncoding:NSUTF8StringEncoding] ?: [NSData data]];
+}
+
+- (void)addPresetWithName:(NSString *)name
+                      uid:(NSString *)uid
+                     bank:(NSString *)bank
+                 position:(NSInteger)position
+                 category:(NSInteger)category
+                 favorite:(BOOL)favorite
+                 userText:(NSString *)userText
+                     data:(NSData *)data
+               parameters:(const float *)parameters {
+    S1PresetIndexEntry entry;
+    entry.name = [self addUTF8String:name];
+    entry.uid = [self addUTF8String:uid];
+    entry.bank = [self addUTF8String:bank];
+    entry.userText = [self addUTF8String:userText];
+    entry.searchText = [self addUTF8String:[NSString stringWithFormat:@"%@\n%@", name, userText].lowercaseString];
+    entry.data = [self addString:data];
+    entry.position = (int32_t)position;
+    entry.category = (int32_t)category;
+    entry.flags = favorite ? S1PresetIndexFavorite : 0;
+    _entries.push_back(entry);
+    _parameters.insert(_parameters.end(), parameters, parameters + S1ParameterCount);
+}
+
+- (void)addPresetAtIndex:(NSInteger)index fromIndex:(S1PresetIndex *)presetIndex {
+    [self addPresetWithName:[presetIndex nameAtIndex:index]
+                        uid:[presetIndex uidAtIndex:index]
+                       bank:[presetIndex bankAtIndex:index]
+                   position:[presetIndex positionAtIndex:index]
+                   category:[presetIndex categoryAtIndex:index]
+                   favorite:[presetIndex isFavoriteAtIndex:index]
+                   userText:[presetIndex userTextAtIndex:index]
+                       data:[presetIndex presetDataAtIndex:index]
+                 parameters:[presetIndex parametersAtIndex:index]];
+}
+
+- (BOOL)writeToFile:(NSString *)path fingerprint:(uint64_t)fingerprint {
+    S1PresetIndexHeader header;
+    header.magic = S1PresetIndexMagic;
+    header.version = S1PresetIndexVersion;
+    header.parameterCount = S1ParameterCount;
+    header.presetCount = (uint32_t)_entries.size();
+    header.fingerprint = fingerprint;
+    header.entriesOffset = sizeof(S1PresetIndexHeader);
+    header.parametersOffset = header.entriesOffset + (uint32_t)(_entries.size() * sizeof(S1PresetIndexEntry));
+    header.stringsOffset = header.parametersOffset + (uint32_t)(_parameters.size() * sizeof(float));
+    header.stringsSize = (uint32_t)_strings.size();
+
+    NSMutableData *file = [NSMutableData dataWithCapacity:header.stringsOffset + header.stringsSize];
+    [file appendBytes:&header length:sizeof(header)];
+    [file appendBytes:_entries.data() length:_entries.size() * sizeof(S1PresetIndexEntry)];
+    [file appendBytes:_parameters.data() length:_parameters.size() * sizeof(float)];
+    [file appendBytes:_strings.data() length:_strings.size()];
+    return [file writeToFile:path options:NSDataWritingAtomic error:nil];
+}
+
+@end
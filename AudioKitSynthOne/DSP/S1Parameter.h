@@ -166,6 +166,8 @@ typedef AK_ENUM(S1Parameter) {
 
     adsrPitchTracking = 149,
 
-    S1ParameterCount = 150
+    oversampling = 150, // 0 = 1x, 1 = 2x, 2 = 4x voice rendering
+
+    S1ParameterCount = 151
 } S1Parameter;
 
@@ -13,4 +13,7 @@ public protocol S1TuningTable {
     func getTuningTableFrequency(_ index: Int) -> Double
 
     func setTuningTableNPO(_ npo: Int)
+
+    /// Whole table at once, starting at note number firstNote.  retune: sounding notes move to the new tuning
+    func setTuningTable(_ frequencies: [Double], firstNote: Int, retune: Bool)
 }
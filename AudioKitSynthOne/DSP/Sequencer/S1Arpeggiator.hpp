@@ -9,48 +9,44 @@
 #import "S1AudioUnit.h"
 #import "S1SeqNoteNumber.hpp"
 
-#include <vector>
-
+// Appends arpeggios of heldNotes to the fixed-capacity sequencerNotes starting at index.
+// Returns the new count; notes beyond the capacity of sequencerNotes are dropped.
 template<typename SeqNoteNumbers, typename NoteNumbers>
 struct Arpeggiator {
     Arpeggiator() = delete;
 
-    static int up(SeqNoteNumbers &sequencerNotes, NoteNumbers &sequencerNotes2,
-                   const int heldNotesCount, const int arpOctaves, const int interval) {
-        int index = 0;
+    static int up(SeqNoteNumbers &sequencerNotes, const NoteNumbers &heldNotes,
+                   const int heldNotesCount, const int arpOctaves, const int interval, int index = 0) {
+        const int capacity = (int)sequencerNotes.size();
         for (int octave = 0; octave < arpOctaves; octave++) {
-            for (int i = 0; i < heldNotesCount; i++) {
-                NoteNumber& note = sequencerNotes2[i];
+            for (int i = 0; i < heldNotesCount && index < capacity; i++) {
+                const NoteNumber& note = heldNotes[i];
                 const int nn = note.noteNumber + (octave * interval);
                 const int velocity = note.velocity;
-                SeqNoteNumber snn{nn, 1, velocity};
-                std::vector<SeqNoteNumber>::iterator it = sequencerNotes.begin() + index;
-                sequencerNotes.insert(it, snn);
-                ++index;
+                sequencerNotes[index++] = {nn, 1, velocity};
             }
         }
         return index;
     }
 
-    static void down(SeqNoteNumbers &sequencerNotes, NoteNumbers &sequencerNotes2,
+    static int down(SeqNoteNumbers &sequencerNotes, const NoteNumbers &heldNotes,
                           const int heldNotesCount, const int arpOctaves, const int interval, const bool noTail, int index = 0)
     {
+        const int capacity = (int)sequencerNotes.size();
         for (int octave = arpOctaves - 1; octave >= 0; octave--) {
-            for (int i = heldNotesCount - 1; i >= 0; i--) {
+            for (int i = heldNotesCount - 1; i >= 0 && index < capacity; i--) {
                 const bool firstNote = (i == heldNotesCount - 1) && (octave == arpOctaves - 1);
                 const bool lastNote = (i == 0) && (octave == 0);
                 if ((firstNote || lastNote) && noTail) {
                     continue;
                 }
 
-                NoteNumber& note = sequencerNotes2[i];
+                const NoteNumber& note = heldNotes[i];
                 const int nn = note.noteNumber + (octave * interval);
                 const int velocity = note.velocity;
-                SeqNoteNumber snn{nn, 1, velocity};
-                std::vector<SeqNoteNumber>::iterator it = sequencerNotes.begin() + index;
-                sequencerNotes.insert(it, snn);
-                ++index;
+                sequencerNotes[index++] = {nn, 1, velocity};
             }
         }
+        return index;
     };
 };
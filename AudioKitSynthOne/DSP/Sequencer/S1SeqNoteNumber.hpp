@@ -9,5 +9,7 @@
 struct SeqNoteNumber {
     int noteNumber;
     int onOff;
-    int velocity;
+    int velocity;           // 0: velocity of the held key
+    float gate = 1.f;       // fraction of the step
+    float probability = 1.f;
 };
@@ -7,63 +7,285 @@
 //
 #include <array>
 #include <atomic>
-#include <functional>
-#include <list>
-#include <vector>
+#include <cmath>
 
 #import "Foundation/Foundation.h"
+#import "AEArray.h"
 #import "S1AudioUnit.h"
 #import "S1Parameter.h"
 #import "S1SeqNoteNumber.hpp"
-
-@class AEArray;
+#import "S1SequencerPattern.hpp"
 
 #ifdef __cplusplus
 
 using DSPParameters = std::array<float, S1Parameter::S1ParameterCount>;
-using BeatCounterChangedCallback = std::function<void()>;
-using KeyOnCallback = std::function<void(int, int)>;
-using KeyOffCallback = std::function<void(int)>;
+
+#define S1_MAX_SEQUENCER_NOTES (1024) // 128 midi note numbers * 4 arp octaves * up+down
+#define S1_NUM_SEQUENCER_STEPS (16) // steps of the sequencerPattern, sequencerOctBoost, sequencerNoteOn parameters
+
+// host transport for one render block.  beatPosition is the host beat at the first frame of the block.
+// beatsPerFrame is the kernel's syncTempo, also when the transport is not moving
+typedef struct S1TransportState {
+    bool isMoving;
+    double beatPosition;
+    double beatsPerFrame;
+} S1TransportState;
 
 class S1Sequencer {
 
 public:
-    S1Sequencer() = delete;
-    S1Sequencer(KeyOnCallback keyOnCb, KeyOffCallback keyOffCb, BeatCounterChangedCallback beatChangedCb);
 
     void setSampleRate(double sampleRate);
     void init();
     void reset(bool resetNotes);
     void setNotesPerOctave(int notes);
 
+    // MAIN THREAD, while not rendering: restart the step probability generator from seed; 0 selects the default seed
+    void setRandomSeed(uint32_t seed);
+
     int getArpBeatCount();
-    void process(DSPParameters &params, AEArray *heldNoteNumbersAE);
+
+    // RENDER THREAD: pattern played when arpIsSequencer is on.  Compiled into the step table at the next step;
+    // pattern must stay valid until it is replaced
+    void setPattern(const S1SequencerPattern *pattern);
+
+    // RENDER THREAD: called once per render block, before its first frame.
+    // Handles held-key transitions and finds the frame of the first step boundary in the block.
+    // Steps fall on the host beat grid while transport is moving, otherwise on a local clock at arpRate.
+    // Delegate implements turnOnKey(int noteNumber, int velocity), turnOffKey(int noteNumber) and beatCounterDidChange()
+    template<typename Delegate>
+    void beginBlock(DSPParameters &params, AEArray *heldNoteNumbersAE, int frameCount,
+                    const S1TransportState &transport, Delegate &delegate);
+
+    // RENDER THREAD: called for each frame of the block; plays the step if a boundary falls on frameIndex.  Never allocates.
+    template<typename Delegate>
+    inline void process(DSPParameters &params, AEArray *heldNoteNumbersAE, int frameIndex, Delegate &delegate) {
+        if (frameIndex == mGateOffFrame) {
+            turnOffLastNotes(delegate);
+        }
+        if (frameIndex == mNextStepFrame) {
+            step(params, heldNoteNumbersAE, frameIndex, delegate);
+        }
+    }
 
 private:
+
     double mSampleRate = 0;
-    const int maxSequencerNotes = 1024; // 128 midi note numbers * 4 arp octaves * up+down
-    void reserveNotes(); // Allocate notes before rendering
+
+    // turn off the previous step's notes and play the step whose boundary falls on frameIndex
+    template<typename Delegate>
+    void step(DSPParameters &params, AEArray *heldNoteNumbersAE, int frameIndex, Delegate &delegate);
+
+    // first frame >= fromFrame of the current block at which the beat time reaches beat, or -1
+    int frameForBeat(double beat, int fromFrame) const;
+
+    // first frame >= fromFrame of the current block at which the beat time crosses a step boundary, or -1
+    int nextStepFrame(int fromFrame) const;
+
+    // Regenerate the arp pattern if the held notes or the arp parameters changed since it was built,
+    // compile the step table if the sequencer pattern or notes per octave changed.
+    // Called at a beat boundary so notes per octave is consistent between the pattern and mLastNotes
+    void updatePattern(const DSPParameters &params, AEArray *heldNoteNumbersAE);
+    void compileStepTable(int notesPerOctave);
+
+    // uniform on [0, 1) for step probability
+    inline float random01() {
+        mRandomState ^= mRandomState << 13;
+        mRandomState ^= mRandomState >> 17;
+        mRandomState ^= mRandomState << 5;
+        return (float)(mRandomState >> 8) * (1.f / 16777216.f);
+    }
+
+    template<typename Delegate>
+    inline void turnOnNote(Delegate &delegate, int noteNumber, int velocity) {
+        if (noteNumber >= 0 && noteNumber < S1_NUM_MIDI_NOTES && mLastNotesCount < S1_NUM_MIDI_NOTES) {
+            delegate.turnOnKey(noteNumber, velocity);
+            mLastNotes[mLastNotesCount++] = noteNumber;
+        }
+    }
+
+    template<typename Delegate>
+    inline void turnOffLastNotes(Delegate &delegate) {
+        for (int i = 0; i < mLastNotesCount; i++) {
+            delegate.turnOffKey(mLastNotes[i]);
+        }
+        mLastNotesCount = 0;
+        mGateOffBeat = INFINITY;
+        mGateOffFrame = -1;
+    }
 
     // Array of midi note numbers of NoteState's which have had a noteOn event but not yet a noteOff event.
-    int previousHeldNoteNumbersAECount; // previous render loop held key count
+    int previousHeldNoteNumbersAECount = 0; // previous render loop held key count
 
     // Beattime Counter
     double mBeatTime = 0;
     std::atomic<int> mStepCounter = 0;
 
-    ///once init'd: sequencerNotes can be accessed and mutated only within process and resetDSP
-    std::vector<SeqNoteNumber> sequencerNotes;
-    std::vector<NoteNumber> sequencerNotes2;
+    // step of the beat grid at which the current held keys started the pattern
+    double mStepOrigin = 0;
 
-    ///once init'd: sequencerLastNotes can be accessed and mutated only within process and resetDSP
-    std::list<int> sequencerLastNotes;
+    // beat time at the start of the current block, beats per frame and beats per step; constant over the block
+    double mBlockBeatTime = 0;
+    double mBeatIncrement = 0;
+    double mStepLength = 1;
+    int mBlockFrameCount = 0;
+    int mNextStepFrame = -1;
 
-    std::atomic<int> mNotesPerOctave{12};
+    // end of the gate of the notes of the current step
+    double mGateOffBeat = INFINITY;
+    int mGateOffFrame = -1;
+
+    ///once init'd: the arp pattern can be accessed and mutated only within process and resetDSP
+    std::array<SeqNoteNumber, S1_MAX_SEQUENCER_NOTES> mPattern;
+    int mPatternCount = 0;
+
+    // held notes, oldest first
+    std::array<NoteNumber, S1_NUM_MIDI_NOTES> mHeldNotes;
+    int mHeldNotesCount = 0;
 
-    // Change notifications
-    BeatCounterChangedCallback mBeatCounterDidChange;
-    KeyOnCallback mTurnOnKey;
-    KeyOffCallback mTurnOffKey;
+    // arp parameters and notes per octave the arp pattern was built from
+    using ArpInputs = std::array<float, 4>;
+    ArpInputs mArpInputs;
+
+    // sequencer pattern, and its steps with notes per octave applied
+    const S1SequencerPattern *mSequencerPattern = nullptr;
+    std::array<SeqNoteNumber, S1_MAX_SEQUENCER_STEPS> mStepTable;
+    int mStepCount = 0;
+    int mStepTableNotesPerOctave = 0; // 0: not compiled
+
+    static constexpr uint32_t kDefaultRandomSeed = 0x9E3779B9;
+    uint32_t mRandomState = kDefaultRandomSeed;
+
+    ///once init'd: mLastNotes can be accessed and mutated only within process and resetDSP
+    std::array<int, S1_NUM_MIDI_NOTES> mLastNotes;
+    int mLastNotesCount = 0;
+
+    std::atomic<int> mNotesPerOctave{12};
 };
 
+template<typename Delegate>
+void S1Sequencer::beginBlock(DSPParameters &params, AEArray *heldNoteNumbersAE, int frameCount,
+                             const S1TransportState &transport, Delegate &delegate) {
+
+    /// MARK: ARPEGGIATOR + SEQUENCER BEGIN
+    mNextStepFrame = -1;
+    mGateOffFrame = -1;
+    const int heldNoteNumbersAECount = AEArrayGetCount(AEArrayGetToken(heldNoteNumbersAE));
+    const BOOL arpSeqIsOn = (params[arpIsOn] == 1.f);
+    const BOOL firstTimeAnyKeysHeld = (previousHeldNoteNumbersAECount == 0 && heldNoteNumbersAECount > 0);
+    const BOOL firstTimeNoKeysHeld = (heldNoteNumbersAECount == 0 && previousHeldNoteNumbersAECount > 0);
+    previousHeldNoteNumbersAECount = heldNoteNumbersAECount;
+
+    // reset arp/seq when user goes from 0 to N, or N to 0 held keys
+    if ( arpSeqIsOn && (firstTimeNoKeysHeld || firstTimeAnyKeysHeld) ) {
+
+        // the local clock restarts with the keys, the host beat grid does not
+        if (!transport.isMoving) {
+            mBeatTime = 0; // reset internal beattime
+        }
+        mStepCounter = 0;
+
+        // Turn OFF previous beat's notes
+        turnOffLastNotes(delegate);
+
+        delegate.beatCounterDidChange();
+    }
+
+    // beat time only advances if arp is ON, or if previous beat's notes need to be turned OFF
+    if ( !arpSeqIsOn && mLastNotesCount == 0 ) {
+        return;
+    }
+
+    // tempo and step length are sampled once per block
+    if (transport.isMoving) {
+        mBlockBeatTime = transport.beatPosition;
+        mBeatIncrement = transport.beatsPerFrame;
+    } else {
+        mBlockBeatTime = mBeatTime;
+        mBeatIncrement = transport.beatsPerFrame;
+    }
+    mStepLength = params[arpSeqTempoMultiplier];
+    mBlockFrameCount = frameCount;
+    mBeatTime = mBlockBeatTime + frameCount * mBeatIncrement;
+
+    // gate of the previous step may end in this block
+    mGateOffFrame = mLastNotesCount > 0 ? frameForBeat(mGateOffBeat, 0) : -1;
+
+    // the pattern starts at the step of the first frame
+    if (firstTimeAnyKeysHeld) {
+        mStepOrigin = std::floor((mBlockBeatTime + mBeatIncrement) / mStepLength);
+    }
+
+    // If keys are now held the step plays on the first frame, otherwise at the next beat boundary
+    mNextStepFrame = firstTimeAnyKeysHeld ? 0 : nextStepFrame(0);
+}
+
+template<typename Delegate>
+void S1Sequencer::step(DSPParameters &params, AEArray *heldNoteNumbersAE, int frameIndex, Delegate &delegate) {
+
+    // beat time at the end of frameIndex
+    const double beatTime = mBlockBeatTime + (frameIndex + 1) * mBeatIncrement;
+    mNextStepFrame = nextStepFrame(frameIndex + 1);
+
+    // Turn off previous beat's notes even if arp is off
+    turnOffLastNotes(delegate);
+
+    // ARP/SEQ is OFF: the beat time stops here
+    if (params[arpIsOn] != 1.f) {
+        mBeatTime = beatTime;
+        mNextStepFrame = -1;
+        return;
+    }
+
+    // Keys are held
+    if (AEArrayGetCount(AEArrayGetToken(heldNoteNumbersAE)) == 0) {
+        return;
+    }
+
+    updatePattern(params, heldNoteNumbersAE);
+
+    // At least one key is held down, and a non-empty sequence has been created
+    const bool isSequencer = params[arpIsSequencer] == 1.f;
+    const int patternCount = isSequencer ? mStepCount : mPatternCount;
+    if ( patternCount > 0 ) {
+
+        // Advance arp/seq beatCounter, notify delegates.
+        // The pattern restarts if the beat moved back before its origin (host loop or relocation)
+        const double stepIndex = std::floor(beatTime / mStepLength);
+        if (stepIndex < mStepOrigin) {
+            mStepOrigin = stepIndex;
+        }
+        mStepCounter.store(static_cast<int>(stepIndex - mStepOrigin));
+        const int seqNotePosition = mStepCounter.load() % patternCount;
+        delegate.beatCounterDidChange();
+
+        //MARK: ARP+SEQ: turn ON the note of the sequence
+        const SeqNoteNumber& snn = isSequencer ? mStepTable[seqNotePosition] : mPattern[seqNotePosition];
+
+        if (isSequencer) {
+
+            // SEQUENCER: transpose every held note, most recent first
+            if (snn.onOff == 1 && (snn.probability >= 1.f || random01() < snn.probability)) {
+                for (int i = mHeldNotesCount - 1; i >= 0; i--) {
+                    const NoteNumber& note = mHeldNotes[i];
+                    const int velocity = snn.velocity > 0 ? snn.velocity : note.velocity;
+                    turnOnNote(delegate, note.noteNumber + snn.noteNumber, velocity);
+                }
+            }
+        } else {
+
+            // ARPEGGIATOR
+            turnOnNote(delegate, snn.noteNumber, snn.velocity);
+        }
+
+        // notes are turned off by the next step, or at the end of a shorter gate
+        if (mLastNotesCount > 0 && snn.gate < 1.f) {
+            mGateOffBeat = mBlockBeatTime + frameIndex * mBeatIncrement + snn.gate * mStepLength;
+            mGateOffFrame = frameForBeat(mGateOffBeat, frameIndex + 1);
+        }
+    }
+
+    /// MARK: ARPEGGIATOR + SEQUENCER END
+}
+
 #endif
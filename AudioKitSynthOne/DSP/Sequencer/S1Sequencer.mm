@@ -14,179 +14,141 @@
 #import "S1ArpModes.hpp"
 #import "S1AudioUnit.h"
 
-
-S1Sequencer::S1Sequencer(KeyOnCallback keyOnCb,
-    KeyOffCallback keyOffCb, BeatCounterChangedCallback beatChangedCb) :
-    mTurnOnKey(keyOnCb),
-    mTurnOffKey(keyOffCb),
-    mBeatCounterDidChange(beatChangedCb)
-    {
-        static_assert(decltype(mStepCounter)::is_always_lock_free, "StepCounter not lockfree!");
-    }
-
 void S1Sequencer::init() {
-    previousHeldNoteNumbersAECount = 0;
-    reserveNotes();
+    static_assert(decltype(mStepCounter)::is_always_lock_free, "StepCounter not lockfree!");
+    reset(true);
 }
 
 void S1Sequencer::reset(bool resetNotes) {
     previousHeldNoteNumbersAECount = resetNotes ? 0 : previousHeldNoteNumbersAECount;
-    sequencerLastNotes.clear();
-    sequencerNotes.clear();
-    sequencerNotes2.clear();
+    mLastNotesCount = 0;
+    mGateOffBeat = INFINITY;
+    mGateOffFrame = -1;
+    mPatternCount = 0;
+    mHeldNotesCount = 0;
+    mNextStepFrame = -1;
+
+    // force updatePattern to rebuild
+    mArpInputs.fill(NAN);
+    mStepTableNotesPerOctave = 0;
+}
+
+void S1Sequencer::setPattern(const S1SequencerPattern *pattern) {
+    mSequencerPattern = pattern;
+    mStepTableNotesPerOctave = 0;
 }
 
-void S1Sequencer::process(DSPParameters &params, __weak AEArray *heldNoteNumbersAE) {
-    
-    /// MARK: ARPEGGIATOR + SEQUENCER BEGIN
-    const int heldNoteNumbersAECount = heldNoteNumbersAE.count;
-    const BOOL arpSeqIsOn = (params[arpIsOn] == 1.f);
-    const BOOL firstTimeAnyKeysHeld = (previousHeldNoteNumbersAECount == 0 && heldNoteNumbersAECount > 0);
-    const BOOL firstTimeNoKeysHeld = (heldNoteNumbersAECount == 0 && previousHeldNoteNumbersAECount > 0);
-    
-    // reset arp/seq when user goes from 0 to N, or N to 0 held keys
-    if ( arpSeqIsOn && (firstTimeNoKeysHeld || firstTimeAnyKeysHeld) ) {
-        
-        mBeatTime = 0; // reset internal beattime
-        mStepCounter = 0;
-
-        // Turn OFF previous beat's notes
-        std::for_each(sequencerLastNotes.begin(), sequencerLastNotes.end(), [&] (const auto &note) {
-            mTurnOffKey(note);
-        });
-        sequencerLastNotes.clear();
-        
-        mBeatCounterDidChange();
+int S1Sequencer::frameForBeat(double beat, int fromFrame) const {
+    if (mBeatIncrement <= 0.0 || fromFrame >= mBlockFrameCount) {
+        return -1;
+    }
+    // the beat time at the end of frame i is mBlockBeatTime + (i + 1) * mBeatIncrement
+    const double frame = std::ceil((beat - mBlockBeatTime) / mBeatIncrement) - 1.0;
+    if (!(frame < mBlockFrameCount)) {
+        return -1;
     }
-    
-    // If arp is ON, or if previous beat's notes need to be turned OFF
-    if ( arpSeqIsOn || sequencerLastNotes.size() > 0 ) {
-        
-        // Compare previous beatTime to current to see if we crossed a beat boundary
-        const auto newBeatTime = mBeatTime + (params[arpRate] / 60.f) / mSampleRate;
-        const double r0 = fmod(mBeatTime, params[arpSeqTempoMultiplier]);
-        mBeatTime = newBeatTime;
-        const double r1 = fmod(mBeatTime, params[arpSeqTempoMultiplier]);
-        
-        // If keys are now held, or if beat boundary was crossed
-        if ( firstTimeAnyKeysHeld || r1 < r0 ) {
-            
-            // Turn off previous beat's notes even if arp is off
-            std::for_each(sequencerLastNotes.begin(), sequencerLastNotes.end(), [&] (const auto &note) {
-                mTurnOffKey(note);
-            });
-            sequencerLastNotes.clear();
-            
-            // ARP/SEQ is ON
-            if (arpSeqIsOn) {
-                
-                // Held Notes
-                if (heldNoteNumbersAECount > 0) {
-                    // Create Arp/Seq array based on held notes and/or sequence parameters
-                    sequencerNotes.clear();
-                    sequencerNotes2.clear();
-                    
-                    // Only update "notes per octave" when beat counter changes so sequencerNotes and sequencerLastNotes match
-
-                    if (mNotesPerOctave.load() <= 0) mNotesPerOctave.store(12);
-                    const float npof = (float)mNotesPerOctave.load()/12.f; // 12ET ==> npof = 1
-                    
-                    if ( params[arpIsSequencer] == 1.f ) {
-                        
-                        // SEQUENCER
-                        const int numSteps = params[arpTotalSteps] > 16 ? 16 : (int)params[arpTotalSteps];
-                        for(int i = 0; i < numSteps; i++) {
-                            const int onOff = params[(S1Parameter)(i + sequencerNoteOn00)];
-                            const int octBoost = params[(S1Parameter)(i + sequencerOctBoost00)];
-                            const int nn = params[(S1Parameter)(i + sequencerPattern00)] * npof;
-                            const int nnob = (nn < 0) ? (nn - octBoost * mNotesPerOctave.load()) : (nn + octBoost * mNotesPerOctave.load());
-
-                            // sequencer note velocity is reassigned below when constructed sequence is played
-                            sequencerNotes.push_back({nnob, onOff, 127});
-                        }
-                    } else {
-                        
-                        // ARPEGGIATOR
-                        AEArrayEnumeratePointers(heldNoteNumbersAE, NoteNumber *, note) {
-                            std::vector<NoteNumber>::iterator it = sequencerNotes2.begin();
-                            sequencerNotes2.insert(it, *note);
-                        }
-                        const int heldNotesCount = (int)sequencerNotes2.size();
-                        const int arpIntervalUp = params[arpInterval] * npof;
-                        const int arpOctaves = (int)params[arpOctave] + 1;
-                        const auto arpMode = static_cast<ArpeggiatorMode>(params[arpDirection]);
-
-                        switch(arpMode) {
-                            case ArpeggiatorMode::Up: {
-                                Arpeggiator<decltype(sequencerNotes), decltype(sequencerNotes2)>::up(
-                                     sequencerNotes, sequencerNotes2, heldNotesCount, arpOctaves, arpIntervalUp);
-                                break;
-                            }
-                            case ArpeggiatorMode::UpDown: {
-                                int index = Arpeggiator<decltype(sequencerNotes), decltype(sequencerNotes2)>::up(
-                                    sequencerNotes, sequencerNotes2, heldNotesCount, arpOctaves, arpIntervalUp);
-                                const bool noTail = true;
-                                Arpeggiator<decltype(sequencerNotes), decltype(sequencerNotes2)>::down(
-                                    sequencerNotes, sequencerNotes2, heldNotesCount, arpOctaves, arpIntervalUp, noTail, index);
-                                break;
-                            }
-                            case ArpeggiatorMode::Down: {
-                                Arpeggiator<decltype(sequencerNotes), decltype(sequencerNotes2)>::down(
-                                    sequencerNotes, sequencerNotes2, heldNotesCount, arpOctaves, arpIntervalUp, false);
-                                break;
-                            }
-                        }
-                    }
-                    
-                    // At least one key is held down, and a non-empty sequence has been created
-                    if ( sequencerNotes.size() > 0 ) {
-                        
-                        // Advance arp/seq beatCounter, notify delegates
-                        mStepCounter.store(static_cast<int>(mBeatTime / params[arpSeqTempoMultiplier]));
-                        const int seqNotePosition = mStepCounter.load() % sequencerNotes.size();
-                        mBeatCounterDidChange();
-                        
-                        //MARK: ARP+SEQ: turn ON the note of the sequence
-                        SeqNoteNumber& snn = sequencerNotes[seqNotePosition];
-                        
-                        if (params[arpIsSequencer] == 1.f) {
-                            
-                            // SEQUENCER
-                            if (snn.onOff == 1) {
-                                AEArrayEnumeratePointers(heldNoteNumbersAE, NoteNumber *, noteStruct) {
-                                    const int baseNote = noteStruct->noteNumber;
-                                    const int note = baseNote + snn.noteNumber;
-                                    const int velocity = noteStruct->velocity;
-                                    if (note >= 0 && note < S1_NUM_MIDI_NOTES) {
-                                        mTurnOnKey(note, velocity);
-                                        sequencerLastNotes.push_back(note);
-                                    }
-                                }
-                            }
-                        } else {
-                            
-                            // ARPEGGIATOR
-                            const int note = snn.noteNumber;
-                            const int velocity = snn.velocity;
-                            if (note >= 0 && note < S1_NUM_MIDI_NOTES) {
-                                mTurnOnKey(note, velocity);
-                                sequencerLastNotes.push_back(note);
-                            }
-                        }
-                    }
-                }
-            }
+    return std::max(fromFrame, (int)frame);
+}
+
+// The step boundary crossed at frame i is the first multiple of mStepLength that is
+// greater than the beat time at the start of frame i and at most the beat time at its end
+int S1Sequencer::nextStepFrame(int fromFrame) const {
+    if (mStepLength <= 0.0) {
+        return -1;
+    }
+    const double beatTime = mBlockBeatTime + fromFrame * mBeatIncrement;
+    const double nextBoundary = (std::floor(beatTime / mStepLength) + 1.0) * mStepLength;
+    return frameForBeat(nextBoundary, fromFrame);
+}
+
+void S1Sequencer::updatePattern(const DSPParameters &params, AEArray *heldNoteNumbersAE) {
+
+    if (mNotesPerOctave.load() <= 0) mNotesPerOctave.store(12);
+    const int notesPerOctave = mNotesPerOctave.load();
+
+    // heldNoteNumbersAE is most recent first
+    bool heldNotesChanged = false;
+    AEArrayToken token = AEArrayGetToken(heldNoteNumbersAE);
+    const int heldNotesCount = std::min(AEArrayGetCount(token), S1_NUM_MIDI_NOTES);
+    if (heldNotesCount != mHeldNotesCount) {
+        mHeldNotesCount = heldNotesCount;
+        heldNotesChanged = true;
+    }
+    for (int i = 0; i < heldNotesCount; i++) {
+        const NoteNumber& note = *(NoteNumber *)AEArrayGetItem(token, heldNotesCount - 1 - i);
+        NoteNumber& heldNote = mHeldNotes[i];
+        if (note.noteNumber != heldNote.noteNumber || note.velocity != heldNote.velocity) {
+            heldNote = note;
+            heldNotesChanged = true;
         }
     }
-    previousHeldNoteNumbersAECount = heldNoteNumbersAECount;
-    
-    /// MARK: ARPEGGIATOR + SEQUENCER END
+
+    // SEQUENCER: the step table does not depend on the held notes
+    if (params[arpIsSequencer] == 1.f) {
+        if (notesPerOctave != mStepTableNotesPerOctave) {
+            compileStepTable(notesPerOctave);
+        }
+        if (heldNotesChanged) {
+            mArpInputs.fill(NAN);
+        }
+        return;
+    }
+
+    // ARPEGGIATOR
+    const ArpInputs inputs {{params[arpInterval], params[arpOctave], params[arpDirection], (float)notesPerOctave}};
+    if (inputs == mArpInputs && !heldNotesChanged) {
+        return;
+    }
+    mArpInputs = inputs;
+
+    using Arp = Arpeggiator<decltype(mPattern), decltype(mHeldNotes)>;
+    const float npof = (float)notesPerOctave/12.f; // 12ET ==> npof = 1
+    const int arpIntervalUp = params[arpInterval] * npof;
+    const int arpOctaves = (int)params[arpOctave] + 1;
+    const auto arpMode = static_cast<ArpeggiatorMode>(params[arpDirection]);
+
+    switch(arpMode) {
+        case ArpeggiatorMode::Up: {
+            mPatternCount = Arp::up(mPattern, mHeldNotes, mHeldNotesCount, arpOctaves, arpIntervalUp);
+            break;
+        }
+        case ArpeggiatorMode::UpDown: {
+            const int index = Arp::up(mPattern, mHeldNotes, mHeldNotesCount, arpOctaves, arpIntervalUp);
+            const bool noTail = true;
+            mPatternCount = Arp::down(mPattern, mHeldNotes, mHeldNotesCount, arpOctaves, arpIntervalUp, noTail, index);
+            break;
+        }
+        case ArpeggiatorMode::Down: {
+            mPatternCount = Arp::down(mPattern, mHeldNotes, mHeldNotesCount, arpOctaves, arpIntervalUp, false);
+            break;
+        }
+        default:
+            mPatternCount = 0;
+            break;
+    }
 }
 
-void S1Sequencer::reserveNotes() {
-    sequencerNotes.reserve(maxSequencerNotes);
-    sequencerNotes2.reserve(maxSequencerNotes);
-    sequencerLastNotes.resize(maxSequencerNotes);
+void S1Sequencer::compileStepTable(int notesPerOctave) {
+    mStepTableNotesPerOctave = notesPerOctave;
+    mStepCount = 0;
+    if (mSequencerPattern == nullptr) {
+        return;
+    }
+
+    const float npof = (float)notesPerOctave/12.f; // 12ET ==> npof = 1
+    const int stepCount = std::min(std::max(mSequencerPattern->stepCount, 0), S1_MAX_SEQUENCER_STEPS);
+    for (int i = 0; i < stepCount; i++) {
+        const S1SequencerStep& step = mSequencerPattern->steps[i];
+        const int nn = step.note * npof;
+        const int nnob = (nn < 0) ? (nn - step.octave * notesPerOctave) : (nn + step.octave * notesPerOctave);
+        const int velocity = std::min(std::max(step.velocity, 0), 127);
+        const float gate = std::min(step.gate, 1.f);
+        const float probability = std::min(std::max(step.probability, 0.f), 1.f);
+        // a gate of 0 or less would still sound for one frame: the step is a rest
+        const int onOff = step.isOn && gate > 0.f ? 1 : 0;
+        mStepTable[i] = {nnob, onOff, velocity, gate, probability};
+    }
+    mStepCount = stepCount;
 }
 
 // Getter and Setter
@@ -204,3 +166,8 @@ void S1Sequencer::setNotesPerOctave(int notes)
 {
   mNotesPerOctave.store(notes);
 }
+
+void S1Sequencer::setRandomSeed(uint32_t seed) {
+    // xorshift never leaves 0
+    mRandomState = (seed != 0) ? seed : kDefaultRandomSeed;
+}
@@ -0,0 +1,24 @@
+//
+//  S1SequencerPattern.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Sequencer pattern as published to the render thread, which compiles it into the sequencer's step table.
+
+#pragma once
+
+#import <array>
+#import "S1AudioUnit.h"
+
+#ifdef __cplusplus
+
+struct S1SequencerPattern {
+    // true: play the pattern of the sequencer parameters instead of steps
+    bool usesParameters = false;
+    int stepCount = 0;
+    std::array<S1SequencerStep, S1_MAX_SEQUENCER_STEPS> steps;
+};
+
+#endif
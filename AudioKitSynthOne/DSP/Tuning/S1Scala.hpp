@@ -0,0 +1,61 @@
+//
+//  S1Scala.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Scala scale (.scl) and keyboard mapping (.kbm) files, see http://www.huygens-fokker.org/scala/scl_format.html
+//  Parsing allocates: call from the main thread or a background thread, never from the render thread.
+
+#pragma once
+
+#import <optional>
+#import <string>
+#import <vector>
+#import "S1TuningTable.hpp"
+
+#ifdef __cplusplus
+
+struct S1ScalaScale {
+    std::string description;
+
+    // degrees 1...N in cents; degree 0 (1/1) is implicit and degree N is the period
+    std::vector<double> cents;
+
+    inline int size() const { return (int)cents.size(); }
+    inline double period() const { return cents.back(); }
+
+    // cents of any degree, negative or beyond the period
+    double degreeCents(int degree) const;
+};
+
+struct S1ScalaKeyboardMapping {
+    int firstNote = 0;
+    int lastNote = S1_NUM_MIDI_NOTES - 1;
+
+    // key of scale degree 0
+    int middleNote = 60;
+    int referenceNote = 60;
+    double referenceFrequency = 261.6255653006;
+
+    // scale degree of one repetition of the mapping; 0: the period of the scale
+    int octaveDegree = 0;
+
+    // scale degree of each key of one repetition starting at middleNote; kUnmapped for 'x'.
+    // Empty: linear mapping, key middleNote + n plays degree n
+    std::vector<int> mapping;
+
+    static constexpr int kUnmapped = -1;
+};
+
+// std::nullopt if the file is malformed
+std::optional<S1ScalaScale> S1ParseScalaScale(const std::string &scl);
+std::optional<S1ScalaKeyboardMapping> S1ParseScalaKeyboardMapping(const std::string &kbm);
+
+// frequencies of the keys firstNote...lastNote.  Unmapped keys repeat the nearest mapped key below them, or above
+// them if there is none.
+// Returns false if no key is mapped or the reference note is unmapped
+bool S1ScalaTuningTable(const S1ScalaScale &scale, const S1ScalaKeyboardMapping &mapping, S1TuningTable &table);
+
+#endif
@@ -0,0 +1,204 @@
+//
+//  S1Scala.mm
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+
+#import <cmath>
+#import <cstdlib>
+#import "S1Scala.hpp"
+
+// Lines of a Scala file that are not comments ("!..."), with leading whitespace and line endings removed
+static std::vector<std::string> scalaLines(const std::string &text) {
+    std::vector<std::string> lines;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string line = text.substr(start, end - start);
+        start = end + 1;
+        const size_t first = line.find_first_not_of(" \t");
+        line.erase(0, first == std::string::npos ? line.size() : first);
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] != '!') {
+            lines.push_back(line);
+        }
+    }
+    // a trailing newline is not an empty last line
+    if (!lines.empty() && lines.back().empty()) {
+        lines.pop_back();
+    }
+    return lines;
+}
+
+static std::optional<long> parseInteger(const std::string &line) {
+    const char *begin = line.c_str();
+    char *end = nullptr;
+    const long value = strtol(begin, &end, 10);
+    if (end == begin) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// "100.0" is cents, "3/2" or "2" is a ratio; anything after the pitch is a comment
+static std::optional<double> parsePitchCents(const std::string &line) {
+    const size_t length = line.find_first_of(" \t");
+    const std::string pitch = line.substr(0, length);
+    const char *begin = pitch.c_str();
+    char *end = nullptr;
+    if (pitch.find('.') != std::string::npos) {
+        const double cents = strtod(begin, &end);
+        if (end == begin || !std::isfinite(cents)) {
+            return std::nullopt;
+        }
+        return cents;
+    }
+    const long numerator = strtol(begin, &end, 10);
+    if (end == begin) {
+        return std::nullopt;
+    }
+    long denominator = 1;
+    if (*end == '/') {
+        const char *denominatorBegin = end + 1;
+        denominator = strtol(denominatorBegin, &end, 10);
+        if (end == denominatorBegin) {
+            return std::nullopt;
+        }
+    }
+    if (numerator <= 0 || denominator <= 0) {
+        return std::nullopt;
+    }
+    return 1200. * log2((double)numerator / (double)denominator);
+}
+
+static long floorDivide(long a, long b) {
+    const long quotient = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? quotient - 1 : quotient;
+}
+
+double S1ScalaScale::degreeCents(int degree) const {
+    const long periods = floorDivide(degree, size());
+    const long index = degree - periods * size();
+    return periods * period() + (index == 0 ? 0. : cents[index - 1]);
+}
+
+std::optional<S1ScalaScale> S1ParseScalaScale(const std::string &scl) {
+    const std::vector<std::string> lines = scalaLines(scl);
+    if (lines.size() < 2) {
+        return std::nullopt;
+    }
+    S1ScalaScale scale;
+    scale.description = lines[0];
+
+    // a scale of only the implicit 1/1 has no period
+    const std::optional<long> count = parseInteger(lines[1]);
+    if (!count || *count < 1 || (size_t)*count > lines.size() - 2) {
+        return std::nullopt;
+    }
+    scale.cents.reserve(*count);
+    for (long i = 0; i < *count; i++) {
+        const std::optional<double> cents = parsePitchCents(lines[i + 2]);
+        if (!cents) {
+            return std::nullopt;
+        }
+        scale.cents.push_back(*cents);
+    }
+    if (scale.period() <= 0.) {
+        return std::nullopt;
+    }
+    return scale;
+}
+
+std::optional<S1ScalaKeyboardMapping> S1ParseScalaKeyboardMapping(const std::string &kbm) {
+    const std::vector<std::string> lines = scalaLines(kbm);
+    if (lines.size() < 7) {
+        return std::nullopt;
+    }
+    const std::optional<long> size = parseInteger(lines[0]);
+    const std::optional<long> firstNote = parseInteger(lines[1]);
+    const std::optional<long> lastNote = parseInteger(lines[2]);
+    const std::optional<long> middleNote = parseInteger(lines[3]);
+    const std::optional<long> referenceNote = parseInteger(lines[4]);
+    const double referenceFrequency = strtod(lines[5].c_str(), nullptr);
+    const std::optional<long> octaveDegree = parseInteger(lines[6]);
+    if (!size || !firstNote || !lastNote || !middleNote || !referenceNote || !octaveDegree) {
+        return std::nullopt;
+    }
+    if (*size < 0 || *lastNote < *firstNote || !(referenceFrequency > 0.) || *octaveDegree < 0) {
+        return std::nullopt;
+    }
+    S1ScalaKeyboardMapping mapping;
+    mapping.firstNote = (int)*firstNote;
+    mapping.lastNote = (int)*lastNote;
+    mapping.middleNote = (int)*middleNote;
+    mapping.referenceNote = (int)*referenceNote;
+    mapping.referenceFrequency = referenceFrequency;
+    mapping.octaveDegree = (int)*octaveDegree;
+
+    // keys without a line are unmapped
+    mapping.mapping.assign(*size, S1ScalaKeyboardMapping::kUnmapped);
+    for (long i = 0; i < *size && (size_t)i + 7 < lines.size(); i++) {
+        const std::string &line = lines[i + 7];
+        if (line[0] == 'x') {
+            continue;
+        }
+        const std::optional<long> degree = parseInteger(line);
+        if (!degree || *degree < 0) {
+            return std::nullopt;
+        }
+        mapping.mapping[i] = (int)*degree;
+    }
+    return mapping;
+}
+
+bool S1ScalaTuningTable(const S1ScalaScale &scale, const S1ScalaKeyboardMapping &mapping, S1TuningTable &table) {
+    const int mapSize = (int)mapping.mapping.size();
+    const int octaveDegree = mapping.octaveDegree == 0 ? scale.size() : mapping.octaveDegree;
+
+    // cents of key relative to degree 0, or NAN if unmapped
+    auto keyCents = [&](int key) -> double {
+        const int offset = key - mapping.middleNote;
+        if (mapSize == 0) {
+            return scale.degreeCents(offset);
+        }
+        const long repetition = floorDivide(offset, mapSize);
+        const int degree = mapping.mapping[offset - repetition * mapSize];
+        if (degree == S1ScalaKeyboardMapping::kUnmapped) {
+            return NAN;
+        }
+        return scale.degreeCents(degree + (int)repetition * octaveDegree);
+    };
+
+    const double referenceCents = keyCents(mapping.referenceNote);
+    if (std::isnan(referenceCents)) {
+        return false;
+    }
+    table.firstNote = mapping.firstNote;
+    table.count = std::min(mapping.lastNote - mapping.firstNote + 1, S1_MAX_TUNING_TABLE_NOTES);
+    table.notesPerOctave = scale.size();
+
+    int firstMapped = -1;
+    for (int i = 0; i < table.count; i++) {
+        const double cents = keyCents(table.firstNote + i);
+        if (std::isnan(cents)) {
+            table.frequencies[i] = firstMapped < 0 ? 0.f : table.frequencies[i - 1];
+            continue;
+        }
+        table.frequencies[i] = (float)(mapping.referenceFrequency * exp2((cents - referenceCents) / 1200.));
+        if (firstMapped < 0) {
+            firstMapped = i;
+        }
+    }
+    if (firstMapped < 0) {
+        return false;
+    }
+    std::fill(table.frequencies.begin(), table.frequencies.begin() + firstMapped, table.frequencies[firstMapped]);
+    return true;
+}
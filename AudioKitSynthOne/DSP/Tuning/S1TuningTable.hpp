@@ -0,0 +1,50 @@
+//
+//  S1TuningTable.hpp
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  Frequencies of a contiguous range of note numbers, published to the render thread as a whole.
+//  Fractional note numbers interpolate between neighbouring entries in log frequency.
+
+#pragma once
+
+#import <algorithm>
+#import <array>
+#import <cmath>
+#import "S1AudioUnit.h"
+
+#ifdef __cplusplus
+
+struct S1TuningTable {
+
+    // note number of frequencies[0]; may be negative so transposed notes stay in the table
+    int firstNote = 0;
+    int count = 0;
+    int notesPerOctave = 12;
+    std::array<float, S1_MAX_TUNING_TABLE_NOTES> frequencies;
+
+    // 12ET at frequencyA4 for MIDI notes 0...127
+    void setEqualTemperament(double frequencyA4 = 440.) {
+        firstNote = 0;
+        count = S1_NUM_MIDI_NOTES;
+        notesPerOctave = 12;
+        for (int i = 0; i < count; i++) {
+            frequencies[i] = (float)(frequencyA4 * exp2((i - 69) / 12.));
+        }
+    }
+
+    // notes outside the table clamp to its first or last entry
+    inline double frequency(double noteNumber) const {
+        const double position = std::min(std::max(noteNumber - firstNote, 0.), (double)(count - 1));
+        const int index = (int)position;
+        const double fraction = position - index;
+        if (fraction == 0.) {
+            return frequencies[index];
+        }
+        return frequencies[index] * pow(frequencies[index + 1] / frequencies[index], fraction);
+    }
+};
+
+#endif
@@ -361,6 +361,9 @@ public class HeaderViewController: UpdatableViewController {
             displayLabel.text = "ADSR Pitch Tracking: \(s.getSynthParameter(.adsrPitchTracking).decimalString)"
         case .isMono:
             displayLabel.text = "Mono: \(s.getSynthParameter(.isMono) == 0 ? "OFF" : "ON")"
+        case .oversampling:
+            let factors = ["1x", "2x", "4x"]
+            displayLabel.text = "Oversampling: \(factors[Int(s.getSynthParameter(.oversampling))])"
 
         default:
             _ = 0
@@ -10,7 +10,8 @@
 
 extension Manager: PresetsDelegate {
 
-    func presetDidChange(_ newActivePreset: Preset) {
+    // parameters: DSP parameters of newActivePreset from the preset index, if it was decoded from it
+    func presetDidChange(_ newActivePreset: Preset, parameters: [Float]?) {
 
         conductor.synth.reset()
 
@@ -21,7 +22,7 @@ extension Manager: PresetsDelegate {
         }
 
         // Set parameters from preset
-        self.loadPreset()
+        self.loadPreset(presetParameters: parameters)
 
         DispatchQueue.main.async {
             self.conductor.updateAllUI()
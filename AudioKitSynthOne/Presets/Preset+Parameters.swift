@@ -0,0 +1,171 @@
+//
+//  Preset+Parameters.swift
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+
+import Foundation
+
+// MARK: - DSP Parameters
+
+extension Preset {
+
+    // The subsets of parameters the DEV panel can freeze when loading a preset
+
+    static let delayParameters: [S1Parameter] = [
+        .delayOn, .delayFeedback, .delayMix, .delayTime, .delayInputCutoffTrackingRatio, .delayInputResonance
+    ]
+
+    static let reverbParameters: [S1Parameter] = [
+        .reverbOn, .reverbFeedback, .reverbHighPass, .reverbMix,
+        .compressorReverbInputRatio, .compressorReverbWetRatio,
+        .compressorReverbInputThreshold, .compressorReverbWetThreshold,
+        .compressorReverbInputAttack, .compressorReverbWetAttack,
+        .compressorReverbInputRelease, .compressorReverbWetRelease,
+        .compressorReverbInputMakeupGain, .compressorReverbWetMakeupGain
+    ]
+
+    static let arpRateParameters: [S1Parameter] = [.arpRate]
+
+    static let arpSeqParameters: [S1Parameter] = {
+        var parameters: [S1Parameter] = [
+            .arpIsOn, .arpIsSequencer, .arpDirection, .arpInterval, .arpOctave, .arpTotalSteps, .arpSeqTempoMultiplier
+        ]
+        for first in [S1Parameter.sequencerPattern00, .sequencerOctBoost00, .sequencerNoteOn00] {
+            parameters += (0..<16).compactMap { S1Parameter(rawValue: first.rawValue + Int32($0)) }
+        }
+        return parameters
+    }()
+
+    static func frozenParameters(_ settings: AppSettings) -> [S1Parameter] {
+        var parameters = [S1Parameter]()
+        if settings.freezeDelay { parameters += delayParameters }
+        if settings.freezeReverb { parameters += reverbParameters }
+        if settings.freezeArpRate { parameters += arpRateParameters }
+        if settings.freezeArpSeq { parameters += arpSeqParameters }
+        return parameters
+    }
+
+    // Version of the mapping dspParameters() makes; bump it whenever that mapping changes so the preset index,
+    // which stores the mapped parameters of every preset, is rebuilt
+    static let dspParametersVersion = 1
+
+    // All S1ParameterCount DSP parameters of this preset, NaN for the ones a preset does not store.
+    // Shared by loading a preset and by the preset index, which stores the result for each preset.
+    func dspParameters() -> [Float] {
+        var parameters = [Float](repeating: .nan, count: Int(S1Parameter.S1ParameterCount.rawValue))
+        func set(_ parameter: S1Parameter, _ value: Double) {
+            parameters[Int(parameter.rawValue)] = Float(value)
+        }
+
+        set(.delayOn, delayToggled)
+        set(.delayFeedback, delayFeedback)
+        set(.delayMix, delayMix)
+        set(.delayTime, delayTime)
+        set(.delayInputCutoffTrackingRatio, delayInputCutoffTrackingRatio)
+        set(.delayInputResonance, delayInputResonance)
+
+        set(.reverbOn, reverbToggled)
+        set(.reverbFeedback, reverbFeedback)
+        set(.reverbHighPass, reverbHighPass)
+        set(.reverbMix, reverbMix)
+        set(.compressorReverbInputRatio, compressorReverbInputRatio)
+        set(.compressorReverbWetRatio, compressorReverbWetRatio)
+        set(.compressorReverbInputThreshold, compressorReverbInputThreshold)
+        set(.compressorReverbWetThreshold, compressorReverbWetThreshold)
+        set(.compressorReverbInputAttack, compressorReverbInputAttack)
+        set(.compressorReverbWetAttack, compressorReverbWetAttack)
+        set(.compressorReverbInputRelease, compressorReverbInputRelease)
+        set(.compressorReverbWetRelease, compressorReverbWetRelease)
+        set(.compressorReverbInputMakeupGain, compressorReverbInputMakeupGain)
+        set(.compressorReverbWetMakeupGain, compressorReverbWetMakeupGain)
+
+        set(.arpRate, arpRate)
+
+        set(.arpIsOn, isArpMode)
+        set(.arpIsSequencer, arpIsSequencer ? 1 : 0)
+        set(.arpDirection, arpDirection)
+        set(.arpInterval, arpInterval)
+        set(.arpOctave, arpOctave)
+        set(.arpTotalSteps, arpTotalSteps)
+        set(.arpSeqTempoMultiplier, arpSeqTempoMultiplier)
+        for i in 0..<16 {
+            parameters[Int(S1Parameter.sequencerPattern00.rawValue) + i] = Float(seqPatternNote[i])
+            parameters[Int(S1Parameter.sequencerOctBoost00.rawValue) + i] = seqOctBoost[i] ? 1 : 0
+            parameters[Int(S1Parameter.sequencerNoteOn00.rawValue) + i] = seqNoteOn[i] ? 1 : 0
+        }
+
+        set(.tempoSyncToArpRate, tempoSyncToArpRate)
+        set(.lfo1Rate, lfoRate)
+        set(.lfo2Rate, lfo2Rate)
+        set(.autoPanFrequency, autoPanFrequency)
+        set(.masterVolume, masterVolume)
+        set(.isMono, isMono)
+        set(.glide, glide)
+        set(.widen, widen)
+        set(.index1, waveform1)
+        set(.index2, waveform2)
+        set(.morph1SemitoneOffset, vco1Semitone)
+        set(.morph2SemitoneOffset, vco2Semitone)
+        set(.morph2Detuning, vco2Detuning)
+        set(.morph1Volume, vco1Volume)
+        set(.morph2Volume, vco2Volume)
+        set(.morphBalance, vcoBalance)
+        set(.subVolume, subVolume)
+        set(.subOctaveDown, subOsc24Toggled)
+        set(.subIsSquare, subOscSquareToggled)
+        set(.fmVolume, fmVolume)
+        set(.fmAmount, fmAmount)
+        set(.noiseVolume, noiseVolume)
+        set(.cutoff, cutoff)
+        set(.resonance, resonance)
+        set(.filterADSRMix, filterADSRMix)
+        set(.filterAttackDuration, filterAttack)
+        set(.filterDecayDuration, filterDecay)
+        set(.filterSustainLevel, filterSustain)
+        set(.filterReleaseDuration, filterRelease)
+        set(.attackDuration, attackDuration)
+        set(.decayDuration, decayDuration)
+        set(.sustainLevel, sustainLevel)
+        set(.releaseDuration, releaseDuration)
+        set(.bitCrushSampleRate, crushFreq)
+        set(.autoPanAmount, autoPanAmount)
+        set(.lfo1Index, lfoWaveform)
+        set(.lfo1Amplitude, lfoAmplitude)
+        set(.lfo2Index, lfo2Waveform)
+        set(.lfo2Amplitude, lfo2Amplitude)
+        set(.cutoffLFO, cutoffLFO)
+        set(.resonanceLFO, resonanceLFO)
+        set(.oscMixLFO, oscMixLFO)
+        set(.reverbMixLFO, reverbMixLFO)
+        set(.decayLFO, decayLFO)
+        set(.noiseLFO, noiseLFO)
+        set(.fmLFO, fmLFO)
+        set(.detuneLFO, detuneLFO)
+        set(.filterEnvLFO, filterEnvLFO)
+        set(.pitchLFO, pitchLFO)
+        set(.bitcrushLFO, bitcrushLFO)
+        set(.tremoloLFO, tremoloLFO)
+        set(.monoIsLegato, isLegato)
+        set(.phaserMix, phaserMix)
+        set(.phaserRate, phaserRate)
+        set(.phaserFeedback, phaserFeedback)
+        set(.phaserNotchWidth, phaserNotchWidth)
+        set(.filterType, filterType)
+        set(.compressorMasterThreshold, compressorMasterThreshold)
+        set(.compressorMasterRatio, compressorMasterRatio)
+        set(.compressorMasterAttack, compressorMasterAttack)
+        set(.compressorMasterRelease, compressorMasterRelease)
+        set(.compressorMasterMakeupGain, compressorMasterMakeupGain)
+        set(.pitchbendMinSemitones, pitchbendMinSemitones)
+        set(.pitchbendMaxSemitones, pitchbendMaxSemitones)
+        set(.frequencyA4, frequencyA4)
+        set(.oscBandlimitEnable, oscBandlimitEnable)
+        set(.transpose, Double(transpose))
+        set(.adsrPitchTracking, adsrPitchTracking)
+
+        return parameters
+    }
+}
@@ -199,9 +199,18 @@ class Preset: Codable {
     // MARK: - JSON Parsing into object
 
     // Init from Dictionary/JSON
+    convenience init(dictionary: [String: Any]) {
+        self.init()
+        setValues(dictionary: dictionary)
+    }
+
+    // Values not decoded yet are decoded here; see IndexedPreset
+    func decodeIfNeeded() {}
+
+    // Set from Dictionary/JSON
     // You MUST match the property name with the dictionary key or you will forever lose the original preset.
 
-    init(dictionary: [String: Any]) {
+    func setValues(dictionary: [String: Any]) {
 
         guard let s = Conductor.sharedInstance.synth else {
             print("ERROR: can't initialize preset until synth is initialized")
@@ -12,58 +12,25 @@ extension Manager {
 
     // MARK: - Preset Load/Save
 
-    func loadPreset() {
+    // presetParameters: the preset's DSP parameters from the preset index, nil to compute them from activePreset
+    func loadPreset(presetParameters: [Float]? = nil) {
 
         guard let s = conductor.synth else {
             print("ERROR:can't load preset if synth is not initialized")
             return
         }
 
-        // The DEV panel has toggles (stored in settings) that impact loading of subsets of parameters of a Preset
-
-        if !appSettings.freezeDelay {
-            s.setSynthParameter(.delayOn, activePreset.delayToggled)
-            s.setSynthParameter(.delayFeedback, activePreset.delayFeedback)
-            s.setSynthParameter(.delayMix, activePreset.delayMix)
-            s.setSynthParameter(.delayTime, activePreset.delayTime)
-            s.setSynthParameter(.delayInputCutoffTrackingRatio, activePreset.delayInputCutoffTrackingRatio)
-            s.setSynthParameter(.delayInputResonance, activePreset.delayInputResonance)
+        // Build the complete parameter set and hand it to the DSP in one call.
+        // Parameters the preset does not store, and frozen subsets, keep their current values.
+        let currentParameters = s.getSynthParameters()
+        var parameters = currentParameters
+        for (i, value) in (presetParameters ?? activePreset.dspParameters()).enumerated() where !value.isNaN {
+            parameters[i] = value
         }
 
-        if !appSettings.freezeReverb {
-            s.setSynthParameter(.reverbOn, activePreset.reverbToggled)
-            s.setSynthParameter(.reverbFeedback, activePreset.reverbFeedback)
-            s.setSynthParameter(.reverbHighPass, activePreset.reverbHighPass)
-            s.setSynthParameter(.reverbMix, activePreset.reverbMix)
-            s.setSynthParameter(.compressorReverbInputRatio, activePreset.compressorReverbInputRatio)
-            s.setSynthParameter(.compressorReverbWetRatio, activePreset.compressorReverbWetRatio)
-            s.setSynthParameter(.compressorReverbInputThreshold, activePreset.compressorReverbInputThreshold)
-            s.setSynthParameter(.compressorReverbWetThreshold, activePreset.compressorReverbWetThreshold)
-            s.setSynthParameter(.compressorReverbInputAttack, activePreset.compressorReverbInputAttack)
-            s.setSynthParameter(.compressorReverbWetAttack, activePreset.compressorReverbWetAttack)
-            s.setSynthParameter(.compressorReverbInputRelease, activePreset.compressorReverbInputRelease)
-            s.setSynthParameter(.compressorReverbWetRelease, activePreset.compressorReverbWetRelease)
-            s.setSynthParameter(.compressorReverbInputMakeupGain, activePreset.compressorReverbInputMakeupGain)
-            s.setSynthParameter(.compressorReverbWetMakeupGain, activePreset.compressorReverbWetMakeupGain)
-        }
-
-        if !appSettings.freezeArpRate {
-            s.setSynthParameter(.arpRate, activePreset.arpRate)
-        }
-
-        if !appSettings.freezeArpSeq {
-            s.setSynthParameter(.arpIsOn, activePreset.isArpMode)
-            s.setSynthParameter(.arpIsSequencer, activePreset.arpIsSequencer ? 1 : 0 )
-            s.setSynthParameter(.arpDirection, activePreset.arpDirection)
-            s.setSynthParameter(.arpInterval, activePreset.arpInterval)
-            s.setSynthParameter(.arpOctave, activePreset.arpOctave)
-            s.setSynthParameter(.arpTotalSteps, activePreset.arpTotalSteps )
-            s.setSynthParameter(.arpSeqTempoMultiplier, activePreset.arpSeqTempoMultiplier)
-            for i in 0..<16 {
-                s.setPattern(forIndex: i, activePreset.seqPatternNote[i])
-                s.setOctaveBoost(forIndex: i, activePreset.seqOctBoost[i] ? 1 : 0)
-                s.setNoteOn(forIndex: i, activePreset.seqNoteOn[i])
-            }
+        // The DEV panel has toggles (stored in settings) that impact loading of subsets of parameters of a Preset
+        for parameter in Preset.frozenParameters(appSettings) {
+            parameters[Int(parameter.rawValue)] = currentParameters[Int(parameter.rawValue)]
         }
 
         if appSettings.saveTuningWithPreset {
@@ -74,75 +41,7 @@ extension Manager {
             }
         }
 
-        s.setSynthParameter(.tempoSyncToArpRate, activePreset.tempoSyncToArpRate)
-        s.setSynthParameter(.lfo1Rate, activePreset.lfoRate)
-        s.setSynthParameter(.lfo2Rate, activePreset.lfo2Rate)
-        s.setSynthParameter(.autoPanFrequency, activePreset.autoPanFrequency)
-        s.setSynthParameter(.masterVolume, activePreset.masterVolume)
-        s.setSynthParameter(.isMono, activePreset.isMono)
-        s.setSynthParameter(.glide, activePreset.glide)
-        s.setSynthParameter(.widen, activePreset.widen)
-        s.setSynthParameter(.index1, activePreset.waveform1)
-        s.setSynthParameter(.index2, activePreset.waveform2)
-        s.setSynthParameter(.morph1SemitoneOffset, activePreset.vco1Semitone)
-        s.setSynthParameter(.morph2SemitoneOffset, activePreset.vco2Semitone)
-        s.setSynthParameter(.morph2Detuning, activePreset.vco2Detuning)
-        s.setSynthParameter(.morph1Volume, activePreset.vco1Volume)
-        s.setSynthParameter(.morph2Volume, activePreset.vco2Volume)
-        s.setSynthParameter(.morphBalance, activePreset.vcoBalance)
-        s.setSynthParameter(.subVolume, activePreset.subVolume)
-        s.setSynthParameter(.subOctaveDown, activePreset.subOsc24Toggled)
-        s.setSynthParameter(.subIsSquare, activePreset.subOscSquareToggled)
-        s.setSynthParameter(.fmVolume, activePreset.fmVolume)
-        s.setSynthParameter(.fmAmount, activePreset.fmAmount)
-        s.setSynthParameter(.noiseVolume, activePreset.noiseVolume)
-        s.setSynthParameter(.cutoff, activePreset.cutoff)
-        s.setSynthParameter(.resonance, activePreset.resonance)
-        s.setSynthParameter(.filterADSRMix, activePreset.filterADSRMix)
-        s.setSynthParameter(.filterAttackDuration, activePreset.filterAttack)
-        s.setSynthParameter(.filterDecayDuration, activePreset.filterDecay)
-        s.setSynthParameter(.filterSustainLevel, activePreset.filterSustain)
-        s.setSynthParameter(.filterReleaseDuration, activePreset.filterRelease)
-        s.setSynthParameter(.attackDuration, activePreset.attackDuration)
-        s.setSynthParameter(.decayDuration, activePreset.decayDuration)
-        s.setSynthParameter(.sustainLevel, activePreset.sustainLevel)
-        s.setSynthParameter(.releaseDuration, activePreset.releaseDuration)
-        s.setSynthParameter(.bitCrushSampleRate, activePreset.crushFreq)
-        s.setSynthParameter(.autoPanAmount, activePreset.autoPanAmount)
-        s.setSynthParameter(.lfo1Index, activePreset.lfoWaveform)
-        s.setSynthParameter(.lfo1Amplitude, activePreset.lfoAmplitude)
-        s.setSynthParameter(.lfo2Index, activePreset.lfo2Waveform)
-        s.setSynthParameter(.lfo2Amplitude, activePreset.lfo2Amplitude)
-        s.setSynthParameter(.cutoffLFO, activePreset.cutoffLFO)
-        s.setSynthParameter(.resonanceLFO, activePreset.resonanceLFO)
-        s.setSynthParameter(.oscMixLFO, activePreset.oscMixLFO)
-        s.setSynthParameter(.reverbMixLFO, activePreset.reverbMixLFO)
-        s.setSynthParameter(.decayLFO, activePreset.decayLFO)
-        s.setSynthParameter(.noiseLFO, activePreset.noiseLFO)
-        s.setSynthParameter(.fmLFO, activePreset.fmLFO)
-        s.setSynthParameter(.detuneLFO, activePreset.detuneLFO)
-        s.setSynthParameter(.filterEnvLFO, activePreset.filterEnvLFO)
-        s.setSynthParameter(.pitchLFO, activePreset.pitchLFO)
-        s.setSynthParameter(.bitcrushLFO, activePreset.bitcrushLFO)
-        s.setSynthParameter(.tremoloLFO, activePreset.tremoloLFO)
-        s.setSynthParameter(.monoIsLegato, activePreset.isLegato )
-        s.setSynthParameter(.phaserMix, activePreset.phaserMix)
-        s.setSynthParameter(.phaserRate, activePreset.phaserRate)
-        s.setSynthParameter(.phaserFeedback, activePreset.phaserFeedback)
-        s.setSynthParameter(.phaserNotchWidth, activePreset.phaserNotchWidth)
-        s.setSynthParameter(.filterType, activePreset.filterType)
-        s.setSynthParameter(.compressorMasterThreshold, activePreset.compressorMasterThreshold)
-        s.setSynthParameter(.compressorMasterRatio, activePreset.compressorMasterRatio)
-        s.setSynthParameter(.compressorMasterAttack, activePreset.compressorMasterAttack)
-        s.setSynthParameter(.compressorMasterRelease, activePreset.compressorMasterRelease)
-        s.setSynthParameter(.compressorMasterMakeupGain, activePreset.compressorMasterMakeupGain)
-        s.setSynthParameter(.pitchbendMinSemitones, activePreset.pitchbendMinSemitones)
-        s.setSynthParameter(.pitchbendMaxSemitones, activePreset.pitchbendMaxSemitones)
-        s.setSynthParameter(.frequencyA4, activePreset.frequencyA4)
-        s.setSynthParameter(.oscBandlimitEnable, activePreset.oscBandlimitEnable)
-        s.setSynthParameter(.transpose, Double(activePreset.transpose))
-        s.setSynthParameter(.adsrPitchTracking, activePreset.adsrPitchTracking)
-
+        s.loadPreset(parameters)
         s.resetSequencer()
         conductor.updateDefaultValues()
     }
@@ -0,0 +1,221 @@
+//
+//  PresetIndex.swift
+//  AudioKitSynthOne
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+
+import Foundation
+import AudioKit
+
+// Memory-mapped S1PresetIndex of the bank files in documents.  Opened on the main thread when the banks load,
+// rebuilt in the background whenever a bank file changes.  The preset browser lists IndexedPresets from it, search
+// reads names and descriptions from it, and a preset change decodes just the selected preset and loads its DSP
+// parameters without mapping them again.
+
+final class PresetIndex {
+
+    // main thread; nil until the index of the current bank files is open
+    private static var shared: PresetIndex?
+
+    // main thread; the last index opened, to copy the unchanged banks from when rebuilding
+    private static var previous: PresetIndex?
+
+    // main thread; fingerprint of the bank files as of the last update, which every bank file change calls
+    private static var currentFingerprint: UInt64?
+
+    // the open index, if no bank file has changed since it was built
+    static var current: PresetIndex? {
+        guard let index = shared, index.index.fingerprint == currentFingerprint else { return nil }
+        return index
+    }
+
+    private static let queue = DispatchQueue(label: "io.audiokit.synthone.presetindex", qos: .utility)
+
+    private static var url: URL {
+        let caches = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask)[0]
+        return caches.appendingPathComponent("presetIndex.s1pi")
+    }
+
+    let index: S1PresetIndex
+    let banks: [Bank]
+
+    // size and modification date of each bank file when the index was opened, by bank name
+    let bankStamps: [String: String]
+
+    private init(index: S1PresetIndex, banks: [Bank], bankStamps: [String: String]) {
+        self.index = index
+        self.banks = banks
+        self.bankStamps = bankStamps
+    }
+
+    // MARK: - Open/Build
+
+    // Size and modification date of each bank file, by bank name
+    static func stamps(_ banks: [Bank]) -> [String: String] {
+        let fileManager = FileManager.default
+        let documents = fileManager.urls(for: .documentDirectory, in: .userDomainMask)[0]
+        var stamps = [String: String]()
+        for bank in banks {
+            let attributes = try? fileManager.attributesOfItem(
+                atPath: documents.appendingPathComponent(bank.name + ".json").path)
+            let size = attributes?[.size] as? UInt64 ?? 0
+            let date = (attributes?[.modificationDate] as? Date)?.timeIntervalSinceReferenceDate ?? 0
+            stamps[bank.name] = "\(size)\t\(date)"
+        }
+        return stamps
+    }
+
+    // The dspParameters mapping version, bank names and order, and the stamp of each bank file: an index with
+    // another fingerprint is stale
+    static func fingerprint(_ banks: [Bank], stamps: [String: String]) -> UInt64 {
+        var description = "\(Preset.dspParametersVersion)\n"
+        for bank in banks.sorted(by: { $0.position < $1.position }) {
+            description += "\(bank.name)\t\(bank.position)\t\(stamps[bank.name] ?? "")\n"
+        }
+
+        // FNV-1a
+        var hash: UInt64 = 0xcbf29ce484222325
+        for byte in description.utf8 {
+            hash = (hash ^ UInt64(byte)) &* 0x100000001b3
+        }
+        return hash
+    }
+
+    // Open the index of the current bank files, or rebuild it in the background if it is missing or stale.  Call
+    // whenever a bank file is saved or removed: current compares against the fingerprint taken here
+    static func update(banks: [Bank]) {
+        let stamps = self.stamps(banks)
+        let fingerprint = self.fingerprint(banks, stamps: stamps)
+        currentFingerprint = fingerprint
+        if shared?.index.fingerprint == fingerprint {
+            return
+        }
+        if let index = S1PresetIndex(contentsOfFile: url.path, fingerprint: fingerprint) {
+            shared = PresetIndex(index: index, banks: banks, bankStamps: stamps)
+            previous = shared
+            return
+        }
+        shared = nil
+        let previous = self.previous
+        queue.async {
+            build(banks: banks, stamps: stamps, fingerprint: fingerprint, previous: previous)
+            DispatchQueue.main.async {
+                // the banks may have changed again while building
+                if shared == nil, let index = S1PresetIndex(contentsOfFile: url.path, fingerprint: fingerprint) {
+                    shared = PresetIndex(index: index, banks: banks, bankStamps: stamps)
+                    self.previous = shared
+                }
+            }
+        }
+    }
+
+    // Index every preset of the bank files in documents.  Banks whose file is unchanged since previous was opened
+    // are copied from it, so saving a bank parses just that bank
+    private static func build(banks: [Bank], stamps: [String: String], fingerprint: UInt64, previous: PresetIndex?) {
+        let writer = S1PresetIndexWriter()
+        let documents = FileManager.default.urls(for: .documentDirectory, in: .userDomainMask)[0]
+        for bank in banks {
+            if let previous = previous, let stamp = previous.bankStamps[bank.name], stamp == stamps[bank.name] {
+                for i in previous.index.indexesOfPresets(bank: bank.name) {
+                    writer.addPreset(at: i, from: previous.index)
+                }
+                continue
+            }
+            let bankURL = documents.appendingPathComponent(bank.name + ".json")
+            guard let data = try? Data(contentsOf: bankURL),
+                let jsonArray = (try? JSONSerialization.jsonObject(with: data, options: [])) as? [Any] else { continue }
+            for presetJSON in jsonArray {
+                guard let presetDictionary = presetJSON as? [String: Any],
+                    let presetData = try? JSONSerialization.data(withJSONObject: presetDictionary, options: []) else { continue }
+                let preset = Preset(dictionary: presetDictionary)
+                let parameters = preset.dspParameters()
+                writer.addPreset(withName: preset.name,
+                                 uid: preset.uid,
+                                 bank: preset.bank,
+                                 position: preset.position,
+                                 category: preset.category,
+                                 favorite: preset.isFavorite,
+                                 userText: preset.userText,
+                                 data: presetData,
+                                 parameters: parameters)
+            }
+        }
+        if !writer.write(toFile: url.path, fingerprint: fingerprint) {
+            AKLog("error writing preset index")
+        }
+    }
+
+    // MARK: - Lookup
+
+    // Every indexed preset with just the values the browser shows, in bank file order
+    func presets() -> [Preset] {
+        return (0..<index.count).map { i in
+            let preset = IndexedPreset()
+            preset.uid = index.uid(at: i)
+            preset.position = index.position(at: i)
+            preset.name = index.name(at: i)
+            preset.bank = index.bank(at: i)
+            preset.category = index.category(at: i)
+            preset.isFavorite = index.isFavorite(at: i)
+            preset.userText = index.userText(at: i)
+            preset.source = (self, i)
+            return preset
+        }
+    }
+
+    // The indexed copy of preset, if it matches
+    func indexOf(_ preset: Preset) -> Int? {
+        let i = index.indexOfPreset(bank: preset.bank, position: preset.position)
+        guard i != NSNotFound, index.uid(at: i) == preset.uid, index.name(at: i) == preset.name else { return nil }
+        return i
+    }
+
+    // Decode one preset
+    func preset(at i: Int) -> Preset? {
+        let presetJSON = try? JSONSerialization.jsonObject(with: index.presetData(at: i), options: [])
+        guard let presetDictionary = presetJSON as? [String: Any] else { return nil }
+        return Preset(dictionary: presetDictionary)
+    }
+
+    // DSP parameters without decoding the preset; NaN for parameters presets do not store
+    func parameters(at i: Int) -> [Float] {
+        let count = Int(S1Parameter.S1ParameterCount.rawValue)
+        return Array(UnsafeBufferPointer(start: index.parameters(at: i), count: count))
+    }
+
+    // uids of the presets whose name or description contains text
+    func uidsOfPresets(containing text: String) -> Set<String> {
+        return Set(index.indexesOfPresets(containing: text).map { index.uid(at: $0) })
+    }
+}
+
+// MARK: - IndexedPreset
+
+// A preset listed from the index.  The values the browser shows and edits are set when it is listed, the rest are
+// decoded from the index the first time the preset is copied, shared or saved
+final class IndexedPreset: Preset {
+
+    // the index and entry to decode from; nil once decoded
+    fileprivate var source: (index: PresetIndex, i: Int)?
+
+    override func decodeIfNeeded() {
+        guard let source = source else { return }
+        self.source = nil
+        let presetJSON = try? JSONSerialization.jsonObject(with: source.index.index.presetData(at: source.i), options: [])
+        guard let presetDictionary = presetJSON as? [String: Any] else { return }
+
+        // keep what the browser may have changed since the preset was listed
+        let (uid, position, name, bank) = (self.uid, self.position, self.name, self.bank)
+        let (category, isFavorite, userText) = (self.category, self.isFavorite, self.userText)
+        setValues(dictionary: presetDictionary)
+        self.uid = uid
+        self.position = position
+        self.name = name
+        self.bank = bank
+        self.category = category
+        self.isFavorite = isFavorite
+        self.userText = userText
+    }
+}
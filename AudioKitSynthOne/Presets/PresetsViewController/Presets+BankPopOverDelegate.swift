@@ -34,6 +34,7 @@ extension PresetsViewController: BankPopOverDelegate {
 
         // Delete old bank json file
         try? Disk.remove(oldName + ".json", from: .documents)
+        PresetIndex.update(banks: conductor.banks)
 
     }
 
@@ -60,6 +61,7 @@ extension PresetsViewController: BankPopOverDelegate {
 
         // Delete bank json file
         try? Disk.remove(bankName + ".json", from: .documents)
+        PresetIndex.update(banks: conductor.banks)
 
     }
 }
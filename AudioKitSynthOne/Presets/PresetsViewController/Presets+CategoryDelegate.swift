@@ -20,6 +20,7 @@ extension PresetsViewController: CategoryDelegate {
         guard let bank = conductor.banks.first(where: { $0.position == bankIndex }) else { return }
         let bankName = bank.name
         let bankPresetsToShare = presets.filter { $0.bank == bankName }
+        bankPresetsToShare.forEach { $0.decodeIfNeeded() }
 
         // Save bank presets to temp directory to be shared
         let bankLocation = "temp/\(bankName).json"
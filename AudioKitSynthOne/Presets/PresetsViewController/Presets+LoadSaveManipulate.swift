@@ -15,15 +15,22 @@ extension PresetsViewController {
     func loadBanks() {
         presets.removeAll()
 
-        for bank in conductor.banks {
-            let fileName = bank.name + ".json"
-
-            // Load presets
-            if Disk.exists(fileName, in: .documents) {
-                loadPresetsFromDevice(fileName)
-            } else {
-                loadFactoryPresets(bank.name)
-                saveAllPresetsIn(bank.name)
+        // List the presets from the preset index if it is current, decoding each one only when it is needed
+        PresetIndex.update(banks: conductor.banks)
+        if let index = PresetIndex.current,
+            conductor.banks.allSatisfy({ Disk.exists($0.name + ".json", in: .documents) }) {
+            presets = index.presets()
+        } else {
+            for bank in conductor.banks {
+                let fileName = bank.name + ".json"
+
+                // Load presets
+                if Disk.exists(fileName, in: .documents) {
+                    loadPresetsFromDevice(fileName)
+                } else {
+                    loadFactoryPresets(bank.name)
+                    saveAllPresetsIn(bank.name)
+                }
             }
         }
 
@@ -104,6 +111,7 @@ extension PresetsViewController {
     func saveAllPresetsIn(_ bank: String) {
         let presetsToSave = presets.filter { $0.bank == bank }.sorted { $0.position < $1.position }
         for (i, preset) in presetsToSave.enumerated() {
+            preset.decodeIfNeeded()
             preset.position = i
         }
         
@@ -112,6 +120,7 @@ extension PresetsViewController {
         do {
             try Disk.save(presetsToSave, to: .documents, as: bank + ".json")
             sortPresets()
+            PresetIndex.update(banks: conductor.banks)
         } catch {
             AKLog("error saving")
         }
@@ -163,12 +172,19 @@ extension PresetsViewController {
 
     func createActivePreset() {
 
+        // activePreset needs to be a unique instance and should not be passed by reference.
+        // A saved preset is decoded from the preset index, with its DSP parameters already mapped
+        if let index = PresetIndex.current, let i = index.indexOf(currentPreset), let activePreset = index.preset(at: i) {
+            presetsDelegate?.presetDidChange(activePreset, parameters: index.parameters(at: i))
+            return
+        }
+
         // TODO: Marcus, or someone... if you want to replace this with deep copy code [copy(with:)]
-        // activePreset needs to be a unique instance and should not be passed by reference
+        currentPreset.decodeIfNeeded()
         do {
             try Disk.save(currentPreset, to: .caches, as: "currentPreset.json")
             if let activePreset = try? Disk.retrieve("currentPreset.json", from: .caches, as: Preset.self) {
-                presetsDelegate?.presetDidChange(activePreset)
+                presetsDelegate?.presetDidChange(activePreset, parameters: nil)
             }
         } catch {
             AKLog("error saving")
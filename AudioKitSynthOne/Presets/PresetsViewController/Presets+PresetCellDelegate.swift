@@ -18,6 +18,7 @@ extension PresetsViewController: PresetCellDelegate {
 
         do {
             // Make unique copy of preset
+            currentPreset.decodeIfNeeded()
             try Disk.save(currentPreset, to: .caches, as: "tmp/presetcopy.json")
             guard let copy = try? Disk.retrieve("tmp/presetcopy.json", from: .caches, as: Preset.self) else { return }
 
@@ -65,6 +66,7 @@ extension PresetsViewController: PresetCellDelegate {
 
         // Save preset to temp directory to be shared
         let presetLocation = "temp/\(currentPreset.name).synth1"
+        currentPreset.decodeIfNeeded()
         try? Disk.save(currentPreset, to: .caches, as: presetLocation)
         guard let path: URL = try? Disk.getURL(for: presetLocation, in: .caches) else { return }
 
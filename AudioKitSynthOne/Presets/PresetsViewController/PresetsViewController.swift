@@ -12,7 +12,7 @@ import Disk
 import GameplayKit
 
 protocol PresetsDelegate: AnyObject {
-    func presetDidChange(_ activePreset: Preset)
+    func presetDidChange(_ activePreset: Preset, parameters: [Float]?)
     func saveEditedPreset(name: String, category: Int, bank: String)
     func banksDidUpdate()
 }
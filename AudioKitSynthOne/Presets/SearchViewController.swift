@@ -74,13 +74,18 @@ extension SearchViewController: UISearchBarDelegate, UISearchResultsUpdating {
         if let searchText = searchController.searchBar.text {
             if !searchText.isEmpty {
                 filteredPresets.removeAll()
-                let compareText = searchText.lowercased();
-                for index in 0..<presets.count {
-                    if presets[index].name.lowercased().contains(
-                        compareText) ||
-                        presets[index].userText.lowercased().contains(
-                            compareText) {
-                        filteredPresets.append(presets[index])
+                if let index = PresetIndex.current {
+                    let uids = index.uidsOfPresets(containing: searchText)
+                    filteredPresets = presets.filter { uids.contains($0.uid) }
+                } else {
+                    let compareText = searchText.lowercased()
+                    for index in 0..<presets.count {
+                        if presets[index].name.lowercased().contains(
+                            compareText) ||
+                            presets[index].userText.lowercased().contains(
+                                compareText) {
+                            filteredPresets.append(presets[index])
+                        }
                     }
                 }
             } else {
@@ -446,10 +446,10 @@ final class Tunings {
     private func tuningDidChange() {
 
         // udpate dsp with global tuning table
-        for i in 0..<127 {
-            let f = AKPolyphonicNode.tuningTable.frequency(forNoteNumber: MIDINoteNumber(i))
-            conductor.synth.setTuningTable(f, index: i)
+        let frequencies = (0..<128).map {
+            AKPolyphonicNode.tuningTable.frequency(forNoteNumber: MIDINoteNumber($0))
         }
+        conductor.synth.setTuningTable(frequencies, firstNote: 0, retune: false)
         NotificationCenter.default.post(name: .tuningDidChange, object: nil)
     }
 }
@@ -0,0 +1,44 @@
+//
+//  GoldenOutputTests.swift
+//  AudioKitSynthOneTests
+//
+//  Created by AudioKit Contributors on 10/18/26.
+//  Copyright © 2026 AudioKit. All rights reserved.
+//
+//  DEBUG builds: the golden output check of the factory presets, like the check it runs.
+
+#if DEBUG
+
+import XCTest
+@testable import AudioKitSynthOne
+
+class GoldenOutputTests: XCTestCase {
+
+    // Every factory preset renders within tolerance of goldenOutput.json of this bundle.  After an intended change to
+    // the sound, record a new reference with the -S1GoldenOutput record launch argument and replace the file.
+    // Skipped until a reference with presets is recorded: without one there is nothing to compare with
+    func testFactoryPresetsMatchGoldenOutput() throws {
+        guard let referenceURL = Bundle(for: GoldenOutputTests.self).url(forResource: "goldenOutput",
+                                                                         withExtension: "json") else {
+            XCTFail("goldenOutput.json is not in the test bundle")
+            return
+        }
+        let reference = try JSONDecoder().decode(AKSynthOne.GoldenOutputReference.self,
+                                                 from: Data(contentsOf: referenceURL))
+        if reference.presets.isEmpty {
+            throw XCTSkip("goldenOutput.json has no presets; record one on a device with -" +
+                "\(AKSynthOne.goldenOutputModeKey) record and replace AudioKitSynthOneTests/goldenOutput.json with it")
+        }
+        let checked = expectation(description: "golden output check")
+        AKSynthOne.runGoldenOutputCheck(record: false,
+                                        tolerance: AKSynthOne.goldenOutputDefaultTolerance,
+                                        referenceURL: referenceURL) { report, passed in
+            XCTAssertTrue(passed, report)
+            checked.fulfill()
+        }
+        // renders a few seconds of every factory preset
+        waitForExpectations(timeout: 600)
+    }
+}
+
+#endif